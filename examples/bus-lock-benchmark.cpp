@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/Error.hpp"
+#include "hal/i2c/II2c.hpp"
+
+#include <osal/Mutex.hpp>
+#include <osal/Timeout.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+/// Represents the I2C driver, which doesn't touch any hardware, so that only the cost of the interface is measured.
+class NullI2c : public hal::i2c::II2c {
+private:
+    std::error_code drvOpen() override { return hal::Error::eOk; }
+
+    std::error_code drvClose() override { return hal::Error::eOk; }
+
+    std::error_code drvWrite(std::uint16_t /*address*/,
+                             const std::uint8_t* /*bytes*/,
+                             std::size_t /*size*/,
+                             bool /*stop*/,
+                             osal::Timeout /*timeout*/) override
+    {
+        return hal::Error::eOk;
+    }
+
+    Result<std::size_t> drvRead(std::uint16_t /*address*/,
+                                std::uint8_t* /*bytes*/,
+                                std::size_t size,
+                                osal::Timeout /*timeout*/) override
+    {
+        return size;
+    }
+};
+
+constexpr std::size_t cIterations = 1'000'000;
+
+/// Measures the average time of the given operation.
+/// @param name             Name of the operation.
+/// @param operation        Operation to be measured.
+template <typename Operation>
+void measure(const char* name, Operation operation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < cIterations; ++i)
+        operation();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    std::printf("%-40s %8.1f ns\n", name, elapsed.count() / cIterations);
+}
+
+} // namespace
+
+/// Measures the per-transfer cost of the bus state validation. The tryLock()/unlock() pair is the cost paid by every
+/// transfer before the ownership tracking (see hal::BusOwner) was introduced.
+int main()
+{
+    NullI2c i2c;
+    i2c.lock(osal::Timeout::infinity());
+    i2c.open();
+
+    const std::uint8_t byte{};
+    measure("II2c::write() of 1 byte", [&] { i2c.write(0x50, &byte, 1, true, osal::Timeout::infinity()); });
+
+    osal::Mutex mutex{OsalMutexType::eRecursive};
+    mutex.lock();
+    measure("recursive mutex tryLock() + unlock()", [&] {
+        mutex.tryLock();
+        mutex.unlock();
+    });
+    mutex.unlock();
+
+    i2c.close();
+    i2c.unlock();
+    return 0;
+}
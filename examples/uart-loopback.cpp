@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/Error.hpp"
+#include "hal/uart/LinuxUart.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+/// Reports the result of the single check.
+/// @param name             Name of the check.
+/// @param passed           Flag indicating if the check has passed.
+/// @return Flag indicating if the check has passed.
+bool check(const char* name, bool passed)
+{
+    std::printf("%-50s %s\n", name, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+} // namespace
+
+/// Exercises hal::uart::LinuxUart against the pseudo-terminal, so that it can be run without any hardware. LinuxUart
+/// opens the slave side, while the master side plays the role of the remote device.
+int main()
+{
+    int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+        std::printf("Failed to create the pseudo-terminal: %s\n", std::strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    hal::uart::LinuxUart uart(::ptsname(master));
+    bool passed = check("open()", !uart.open());
+
+    const std::string cMessage = "hello";
+    std::array<std::uint8_t, 16> buffer{};
+    passed &= check("write()", !uart.write(reinterpret_cast<const std::uint8_t*>(cMessage.data()), cMessage.size()));
+    std::size_t received{};
+    while (received < cMessage.size()) {
+        auto chunkSize = ::read(master, buffer.data() + received, buffer.size() - received);
+        if (chunkSize <= 0)
+            break;
+
+        received += static_cast<std::size_t>(chunkSize);
+    }
+
+    passed &= check("remote side receives the written bytes",
+                    received == cMessage.size() && std::memcmp(buffer.data(), cMessage.data(), cMessage.size()) == 0);
+
+    passed &= check("remote side sends bytes", ::write(master, cMessage.data(), cMessage.size()) > 0);
+    auto [size, error] = uart.read(buffer.data(), cMessage.size(), std::chrono::milliseconds(100));
+    passed &= check("read() receives the sent bytes", !error && size && *size == cMessage.size());
+
+    auto [timeoutSize, timeoutError] = uart.read(buffer.data(), buffer.size(), std::chrono::milliseconds(50));
+    passed &= check("read() without data times out", !timeoutError && timeoutSize && *timeoutSize == 0);
+
+    ::close(master);
+    auto [hangupSize, hangupError] = uart.read(buffer.data(), buffer.size(), std::chrono::milliseconds(50));
+    passed &= check("read() after hangup fails", hangupError == hal::Error::eHardwareError);
+    static_cast<void>(hangupSize);
+
+    uart.close();
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
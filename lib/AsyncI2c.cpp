@@ -0,0 +1,195 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/i2c/AsyncI2c.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <osal/ScopedLock.hpp>
+
+#include <utility>
+
+namespace hal::i2c {
+
+AsyncI2c::AsyncI2c(std::shared_ptr<II2c> i2c, std::size_t queueSize, std::chrono::milliseconds lockTimeout)
+    : m_i2c(std::move(i2c))
+    , m_lockTimeout(lockTimeout)
+    , m_queue(queueSize)
+    , m_freeSlots(static_cast<unsigned int>(queueSize))
+{}
+
+AsyncI2c::~AsyncI2c()
+{
+    stop();
+}
+
+std::error_code AsyncI2c::start()
+{
+    if (isRunning()) {
+        I2cLogger::error("Failed to start async worker: already running");
+        return Error::eWrongState;
+    }
+
+    m_running = true;
+    if (auto error = m_thread.start([this] { worker(); })) {
+        I2cLogger::error("Failed to start async worker: err={}", error.message());
+        m_running = false;
+        return error;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code AsyncI2c::stop()
+{
+    if (!isRunning())
+        return Error::eWrongState;
+
+    {
+        // Flag is cleared under the queue lock, so that every transaction enqueued by submit() is either in
+        // the queue drained below or rejected.
+        osal::ScopedLock lock(m_mutex);
+        m_running = false;
+    }
+
+    m_usedSlots.signal();
+    if (auto error = m_thread.join())
+        return error;
+
+    I2cTransaction transaction;
+    while (pop(transaction)) {
+        if (transaction.callback)
+            transaction.callback(Error::eWrongState);
+    }
+
+    // Wake-ups of the drained transactions are consumed, so that they don't wake the next worker in vain.
+    while (!m_usedSlots.tryWait()) {}
+
+    return Error::eOk;
+}
+
+std::error_code AsyncI2c::submit(I2cTransaction transaction, osal::Timeout timeout)
+{
+    if (transaction.messages == nullptr || transaction.count == 0) {
+        I2cLogger::error("Failed to submit: messages={}, count={}", fmt::ptr(transaction.messages), transaction.count);
+        return Error::eInvalidArgument;
+    }
+
+    if (!isRunning()) {
+        I2cLogger::error("Failed to submit: async worker is not running");
+        return Error::eWrongState;
+    }
+
+    if (auto error = m_freeSlots.timedWait(timeout)) {
+        I2cLogger::warn("Failed to submit: queue is full (timeout={} ms)", osal::durationMs(timeout));
+        return Error::eTimeout;
+    }
+
+    {
+        osal::ScopedLock lock(m_mutex);
+        if (!isRunning()) {
+            m_freeSlots.signal();
+            I2cLogger::error("Failed to submit: async worker has been stopped");
+            return Error::eWrongState;
+        }
+
+        m_queue[m_tail] = std::move(transaction);
+        m_tail = (m_tail + 1) % m_queue.size();
+        ++m_count;
+    }
+
+    m_usedSlots.signal();
+    return Error::eOk;
+}
+
+void AsyncI2c::worker()
+{
+    I2cTransaction transaction;
+
+    while (true) {
+        m_usedSlots.wait();
+        if (!isRunning())
+            break;
+
+        if (!pop(transaction))
+            continue;
+
+        if (auto error = m_i2c->lock(makeTimeout(m_lockTimeout))) {
+            I2cLogger::error("Async worker failed to lock the bus: err={}", error.message());
+            if (transaction.callback)
+                transaction.callback(error);
+
+            continue;
+        }
+
+        // Batch loop may consume the wake-up signalled by stop(), so the running flag is checked again after it.
+        execute(transaction);
+        while (isRunning() && !m_usedSlots.tryWait()) {
+            if (pop(transaction))
+                execute(transaction);
+        }
+
+        m_i2c->unlock();
+        if (!isRunning())
+            break;
+    }
+}
+
+bool AsyncI2c::pop(I2cTransaction& transaction)
+{
+    {
+        osal::ScopedLock lock(m_mutex);
+        if (m_count == 0)
+            return false;
+
+        transaction = std::move(m_queue[m_head]);
+        m_queue[m_head] = {};
+        m_head = (m_head + 1) % m_queue.size();
+        --m_count;
+    }
+
+    m_freeSlots.signal();
+    return true;
+}
+
+void AsyncI2c::execute(I2cTransaction& transaction)
+{
+    auto error = m_i2c->transfer(transaction.messages, transaction.count, transaction.timeout);
+    if (error)
+        I2cLogger::error("Async transaction failed: err={}", error.message());
+
+    if (transaction.callback)
+        transaction.callback(error);
+}
+
+} // namespace hal::i2c
@@ -0,0 +1,147 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/BufferPool.hpp"
+
+#include <osal/ScopedLock.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+
+namespace hal {
+
+BufferPool::BufferPool(std::initializer_list<SizeClass> sizeClasses,
+                       std::pmr::memory_resource* upstream,
+                       std::size_t blockAlignment,
+                       std::pmr::memory_resource* arenaResource)
+    : m_upstream(upstream)
+    , m_arenaResource(arenaResource)
+    , m_blockAlignment(std::bit_ceil(std::max(blockAlignment, alignof(void*))))
+{
+    std::vector<SizeClass> sorted(sizeClasses);
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.blockSize < b.blockSize; });
+
+    for (auto& sizeClass : sorted) {
+        auto blockSize = std::max<std::size_t>(sizeClass.blockSize, 1);
+        sizeClass.blockSize = (blockSize + m_blockAlignment - 1) / m_blockAlignment * m_blockAlignment;
+        m_arenaSize += sizeClass.blockSize * sizeClass.blockCount;
+    }
+
+    if (m_arenaSize == 0)
+        return;
+
+    m_arena = static_cast<std::byte*>(m_arenaResource->allocate(m_arenaSize, m_blockAlignment));
+
+    auto* begin = m_arena;
+    for (const auto& sizeClass : sorted) {
+        Slab slab{sizeClass.blockSize, begin, begin + sizeClass.blockSize * sizeClass.blockCount, nullptr};
+        for (auto* block = slab.begin; block != slab.end; block += slab.blockSize) {
+            *reinterpret_cast<void**>(block) = slab.freeList;
+            slab.freeList = block;
+        }
+
+        m_slabs.push_back(slab);
+        begin = slab.end;
+    }
+}
+
+BufferPool::~BufferPool()
+{
+    assert(m_stats.blocksInUse == 0);
+
+    if (m_arena != nullptr)
+        m_arenaResource->deallocate(m_arena, m_arenaSize, m_blockAlignment);
+}
+
+BufferPoolStats BufferPool::stats() const
+{
+    osal::ScopedLock lock(m_mutex);
+    return m_stats;
+}
+
+void* BufferPool::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment <= m_blockAlignment) {
+        osal::ScopedLock lock(m_mutex);
+
+        for (auto& slab : m_slabs) {
+            if (slab.blockSize < bytes || slab.freeList == nullptr)
+                continue;
+
+            void* block = slab.freeList;
+            slab.freeList = *static_cast<void**>(block);
+
+            ++m_stats.hits;
+            ++m_stats.blocksInUse;
+            m_stats.peakBlocksInUse = std::max(m_stats.peakBlocksInUse, m_stats.blocksInUse);
+            return block;
+        }
+
+        ++m_stats.misses;
+    }
+    else {
+        osal::ScopedLock lock(m_mutex);
+        ++m_stats.misses;
+    }
+
+    return m_upstream->allocate(bytes, alignment);
+}
+
+void BufferPool::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+{
+    auto* block = static_cast<std::byte*>(ptr);
+    std::less<> less;
+    if (less(block, m_arena) || !less(block, m_arena + m_arenaSize)) {
+        m_upstream->deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    osal::ScopedLock lock(m_mutex);
+    for (auto& slab : m_slabs) {
+        if (!less(block, slab.end))
+            continue;
+
+        *static_cast<void**>(ptr) = slab.freeList;
+        slab.freeList = ptr;
+        --m_stats.blocksInUse;
+        return;
+    }
+}
+
+bool BufferPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace hal
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/uart/BufferedUart.hpp"
+
+#include "hal/Error.hpp"
+
+#include <osal/sleep.hpp>
+
+#include <array>
+#include <utility>
+
+namespace hal::uart {
+
+BufferedUart::BufferedUart(std::shared_ptr<IUart> uart,
+                           std::size_t rxSize,
+                           std::size_t txSize,
+                           std::chrono::milliseconds pollPeriod)
+    : m_uart(std::move(uart))
+    , m_pollPeriod(pollPeriod)
+    , m_rxRing(rxSize)
+    , m_txRing(txSize)
+{}
+
+BufferedUart::~BufferedUart()
+{
+    stop();
+}
+
+std::error_code BufferedUart::start()
+{
+    if (isRunning())
+        return Error::eWrongState;
+
+    if (!m_uart->isOpened())
+        return Error::eDeviceNotOpened;
+
+    m_running = true;
+    auto rxCallback = [this](const std::uint8_t* bytes, std::size_t size) { return onReceive(bytes, size); };
+    auto txCallback = [this](std::uint8_t* bytes, std::size_t size) { return onTransmit(bytes, size); };
+    auto error = m_uart->startBuffering(rxCallback, txCallback);
+
+    if (error != Error::eNotSupported) {
+        m_interruptDriven = !error;
+        m_running = !error;
+        return error;
+    }
+
+    m_interruptDriven = false;
+    if (auto startError = m_rxThread.start([this] { rxPump(); })) {
+        m_running = false;
+        return startError;
+    }
+
+    if (auto startError = m_txThread.start([this] { txPump(); })) {
+        m_running = false;
+        m_rxThread.join();
+        return startError;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code BufferedUart::stop()
+{
+    if (!isRunning())
+        return Error::eWrongState;
+
+    m_running = false;
+    if (m_interruptDriven)
+        return m_uart->stopBuffering();
+
+    m_txSignal.signal();
+    auto rxError = m_rxThread.join();
+    auto txError = m_txThread.join();
+    return rxError ? rxError : txError;
+}
+
+std::error_code BufferedUart::write(const std::uint8_t* bytes, std::size_t size)
+{
+    if (bytes == nullptr)
+        return Error::eInvalidArgument;
+
+    if (!isRunning())
+        return Error::eWrongState;
+
+    if (m_txRing.capacity() - m_txRing.size() < size)
+        return Error::eNoMemory;
+
+    m_txRing.push(bytes, size);
+    if (m_interruptDriven)
+        return m_uart->notifyTxPending();
+
+    m_txSignal.signal();
+    return Error::eOk;
+}
+
+std::error_code BufferedUart::write(std::span<const std::uint8_t> bytes)
+{
+    return write(bytes.data(), bytes.size());
+}
+
+Result<std::size_t> BufferedUart::read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
+{
+    if (bytes == nullptr)
+        return Error::eInvalidArgument;
+
+    std::size_t received{};
+    while (true) {
+        received += m_rxRing.pop(bytes + received, size - received);
+        if (received == size)
+            break;
+
+        if (m_rxSignal.timedWait(timeout))
+            break;
+    }
+
+    return received;
+}
+
+Result<std::size_t> BufferedUart::read(std::span<std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return read(bytes.data(), bytes.size(), timeout);
+}
+
+std::error_code BufferedUart::flush(osal::Timeout timeout)
+{
+    // Signals left from the previous bursts are consumed, so that the loop below waits for the current one.
+    while (!m_txDoneSignal.tryWait()) {}
+
+    while (!m_txRing.empty() || m_txBusy) {
+        if (!isRunning())
+            return Error::eWrongState;
+
+        if (m_txDoneSignal.timedWait(timeout))
+            return Error::eTimeout;
+    }
+
+    // Empty ring means only that the driver has taken all bytes, while the last of them may still be shifted out
+    // (e.g. from the hardware FIFO or the byte being sent by the TX interrupt).
+    auto error = m_uart->drain();
+    if (error == Error::eNotSupported)
+        return Error::eOk;
+
+    return error;
+}
+
+BufferedUartStats BufferedUart::stats() const
+{
+    BufferedUartStats stats;
+    stats.rxBytes = m_rxBytes.load(std::memory_order_relaxed);
+    stats.txBytes = m_txBytes.load(std::memory_order_relaxed);
+    stats.rxOverruns = m_rxOverruns.load(std::memory_order_relaxed);
+    stats.errors = m_errors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BufferedUart::rxPump()
+{
+    std::array<std::uint8_t, m_cChunkSize> chunk{};
+
+    while (isRunning()) {
+        auto [actualSize, error] = m_uart->read(chunk.data(), chunk.size(), m_pollPeriod);
+
+        // Drivers may return the bytes received before the error (e.g. timeout), so they are kept regardless of it.
+        if (actualSize && *actualSize != 0)
+            onReceive(chunk.data(), *actualSize);
+
+        if (error && error != Error::eTimeout) {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+            osal::sleep(m_pollPeriod);
+        }
+    }
+}
+
+void BufferedUart::txPump()
+{
+    std::array<std::uint8_t, m_cChunkSize> chunk{};
+
+    while (isRunning()) {
+        // Idle polls don't touch the busy flag, otherwise flush() could see it raised and wait for the done signal,
+        // which only the next burst would produce.
+        if (m_txRing.empty()) {
+            m_txSignal.timedWait(m_pollPeriod);
+            continue;
+        }
+
+        // Busy flag is raised before the ring is drained, so that flush() never sees both of them idle in between.
+        // Pump is the only consumer, so the ring cannot become empty before the pop.
+        m_txBusy = true;
+        auto size = m_txRing.pop(chunk.data(), chunk.size());
+        if (auto error = m_uart->write(chunk.data(), size))
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+        else
+            m_txBytes.fetch_add(size, std::memory_order_relaxed);
+
+        m_txBusy = false;
+        if (m_txRing.empty())
+            m_txDoneSignal.signal();
+    }
+
+    m_txBusy = false;
+}
+
+std::size_t BufferedUart::onReceive(const std::uint8_t* bytes, std::size_t size)
+{
+    auto pushed = m_rxRing.push(bytes, size);
+    m_rxBytes.fetch_add(pushed, std::memory_order_relaxed);
+    if (pushed != size)
+        m_rxOverruns.fetch_add(size - pushed, std::memory_order_relaxed);
+
+    if (pushed != 0)
+        m_rxSignal.signal();
+
+    return pushed;
+}
+
+std::size_t BufferedUart::onTransmit(std::uint8_t* bytes, std::size_t size)
+{
+    auto popped = m_txRing.pop(bytes, size);
+    m_txBytes.fetch_add(popped, std::memory_order_relaxed);
+    if (popped != 0 && m_txRing.empty())
+        m_txDoneSignal.signal();
+
+    return popped;
+}
+
+} // namespace hal::uart
@@ -0,0 +1,151 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/BusArbiter.hpp"
+
+#include "hal/Error.hpp"
+
+#include <osal/ScopedLock.hpp>
+
+#include <algorithm>
+
+namespace hal {
+
+BusArbiter::BusArbiter(std::chrono::microseconds maxHoldTime)
+    : m_maxHoldTime(maxHoldTime)
+{}
+
+std::error_code BusArbiter::acquire(BusPriority priority, osal::Timeout timeout)
+{
+    auto start = Clock::now();
+    auto& waiters = m_waiters[static_cast<std::size_t>(priority)];
+    Waiter waiter;
+
+    {
+        osal::ScopedLock lock(m_mutex);
+        if (!m_busy) {
+            m_busy = true;
+            m_holdStart = Clock::now();
+            updateWaitStats(priority, {});
+            return Error::eOk;
+        }
+
+        waiters.push_back(&waiter);
+    }
+
+    auto error = waitForGrant(waiter, timeout);
+
+    osal::ScopedLock lock(m_mutex);
+    if (error && !waiter.granted) {
+        waiters.erase(std::find(waiters.begin(), waiters.end(), &waiter));
+        ++m_stats.priorities[static_cast<std::size_t>(priority)].timeouts;
+        return Error::eTimeout;
+    }
+
+    updateWaitStats(priority, Clock::now() - start);
+    return Error::eOk;
+}
+
+std::error_code BusArbiter::release()
+{
+    osal::ScopedLock lock(m_mutex);
+    if (!m_busy)
+        return Error::eWrongState;
+
+    auto now = Clock::now();
+    auto hold = std::chrono::duration_cast<std::chrono::microseconds>(now - m_holdStart);
+    m_stats.maxHold = std::max(m_stats.maxHold, hold);
+    checkHoldTime(now);
+    m_holdViolated = false;
+
+    for (auto it = m_waiters.rbegin(); it != m_waiters.rend(); ++it) {
+        if (it->empty())
+            continue;
+
+        auto* waiter = it->front();
+        it->pop_front();
+        waiter->granted = true;
+        m_holdStart = now;
+        waiter->semaphore.signal();
+        return Error::eOk;
+    }
+
+    m_busy = false;
+    return Error::eOk;
+}
+
+BusArbiterStats BusArbiter::stats() const
+{
+    osal::ScopedLock lock(m_mutex);
+    return m_stats;
+}
+
+std::error_code BusArbiter::waitForGrant(Waiter& waiter, osal::Timeout timeout)
+{
+    if (m_maxHoldTime.count() == 0)
+        return waiter.semaphore.timedWait(timeout);
+
+    auto checkPeriod = std::chrono::ceil<std::chrono::milliseconds>(m_maxHoldTime);
+    auto checkPeriodMs = std::max<std::uint32_t>(checkPeriod.count(), 1);
+    while (true) {
+        auto waitMs = std::min<std::uint32_t>(checkPeriodMs, osal::durationMs(timeout));
+        if (!waiter.semaphore.timedWait(osal::Timeout(std::chrono::milliseconds(waitMs))))
+            return Error::eOk;
+
+        if (timeout.isExpired())
+            return Error::eTimeout;
+
+        osal::ScopedLock lock(m_mutex);
+        checkHoldTime(Clock::now());
+    }
+}
+
+void BusArbiter::checkHoldTime(Clock::time_point now)
+{
+    if (!m_busy || m_holdViolated || m_maxHoldTime.count() == 0 || now - m_holdStart <= m_maxHoldTime)
+        return;
+
+    m_holdViolated = true;
+    ++m_stats.holdViolations;
+}
+
+void BusArbiter::updateWaitStats(BusPriority priority, Clock::duration wait)
+{
+    auto& stats = m_stats.priorities[static_cast<std::size_t>(priority)];
+    auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(wait);
+
+    ++stats.acquisitions;
+    stats.totalWait += waitUs;
+    stats.maxWait = std::max(stats.maxWait, waitUs);
+}
+
+} // namespace hal
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/DmaBuffer.hpp"
+
+#include <utility>
+
+namespace hal {
+
+DmaBuffer::DmaBuffer(std::size_t size, std::pmr::memory_resource* resource)
+    : m_resource(resource)
+    , m_size(size)
+    , m_capacity((size + cDmaAlignment - 1) / cDmaAlignment * cDmaAlignment)
+{
+    if (m_capacity != 0)
+        m_data = static_cast<std::uint8_t*>(m_resource->allocate(m_capacity, cDmaAlignment));
+}
+
+DmaBuffer::DmaBuffer(DmaBuffer&& other) noexcept
+    : m_resource(std::exchange(other.m_resource, nullptr))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_capacity(std::exchange(other.m_capacity, 0))
+{}
+
+DmaBuffer::~DmaBuffer()
+{
+    release();
+}
+
+DmaBuffer& DmaBuffer::operator=(DmaBuffer&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_resource = std::exchange(other.m_resource, nullptr);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+    }
+
+    return *this;
+}
+
+void DmaBuffer::release()
+{
+    if (m_data != nullptr)
+        m_resource->deallocate(m_data, m_capacity, cDmaAlignment);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_capacity = 0;
+}
+
+} // namespace hal
@@ -63,6 +63,9 @@ std::string ErrorCategory::message(int value) const
         case Error::ePathDoesNotExist: return "path does not exist";
         case Error::eFilesystemError: return "filesystem error";
         case Error::eHardwareError: return "hardware error";
+        case Error::eNack: return "no acknowledge";
+        case Error::eArbitrationLost: return "arbitration lost";
+        case Error::eFrameError: return "malformed frame";
         default: return "(unrecognized error)";
     }
 }
@@ -0,0 +1,187 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/async/Executor.hpp"
+
+#include <osal/ScopedLock.hpp>
+#include <osal/Timeout.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace hal::async {
+
+Executor::~Executor()
+{
+    if (m_workerStarted) {
+        m_stopping = true;
+        m_operationsSignal.signal();
+        m_thread.join();
+    }
+
+    // With the worker stopped, each unfinished task is suspended in exactly one of the queues below.
+    for (auto handle : m_ready)
+        handle.destroy();
+
+    for (const auto& entry : m_timers)
+        entry.handle.destroy();
+
+    for (const auto& entry : m_operations)
+        entry.handle.destroy();
+
+    for (auto handle : m_completed)
+        handle.destroy();
+}
+
+void Executor::spawn(Task task)
+{
+    auto handle = task.release();
+    handle.promise().executor = this;
+    ++m_activeTasks;
+    post(handle);
+}
+
+void Executor::post(std::coroutine_handle<> handle, detail::IOperation* operation)
+{
+    if (operation == nullptr) {
+        m_ready.push_back(handle);
+        return;
+    }
+
+    if (!m_workerStarted) {
+        if (m_thread.start([this] { worker(); })) {
+            // Without the worker the operation can still be completed, only at the cost of blocking other tasks.
+            operation->execute();
+            m_ready.push_back(handle);
+            return;
+        }
+
+        m_workerStarted = true;
+    }
+
+    {
+        osal::ScopedLock lock(m_mutex);
+        m_operations.push_back({handle, operation});
+    }
+
+    ++m_pendingOperations;
+    m_operationsSignal.signal();
+}
+
+void Executor::postAt(std::coroutine_handle<> handle, Clock::time_point timePoint)
+{
+    auto it = std::upper_bound(m_timers.begin(), m_timers.end(), timePoint, [](auto timePoint, const auto& entry) {
+        return timePoint < entry.timePoint;
+    });
+
+    m_timers.insert(it, {handle, timePoint});
+}
+
+bool Executor::runOnce()
+{
+    if (m_pendingOperations != 0) {
+        osal::ScopedLock lock(m_mutex);
+        for (auto handle : m_completed)
+            m_ready.push_back(handle);
+
+        m_pendingOperations -= m_completed.size();
+        m_completed.clear();
+    }
+
+    auto now = Clock::now();
+    auto it = m_timers.begin();
+    for (; it != m_timers.end() && it->timePoint <= now; ++it)
+        post(it->handle);
+
+    m_timers.erase(m_timers.begin(), it);
+
+    if (m_ready.empty())
+        return false;
+
+    auto handle = m_ready.front();
+    m_ready.pop_front();
+
+    handle.resume();
+    if (handle.done()) {
+        handle.destroy();
+        --m_activeTasks;
+    }
+
+    return true;
+}
+
+void Executor::run()
+{
+    while (m_activeTasks != 0) {
+        if (runOnce())
+            continue;
+
+        if (m_timers.empty()) {
+            if (m_pendingOperations == 0)
+                break;
+
+            m_completedSignal.wait();
+            continue;
+        }
+
+        auto timeLeft = std::chrono::ceil<std::chrono::milliseconds>(m_timers.front().timePoint - Clock::now());
+        if (timeLeft.count() > 0)
+            m_completedSignal.timedWait(osal::Timeout(timeLeft));
+    }
+}
+
+void Executor::worker()
+{
+    while (true) {
+        m_operationsSignal.wait();
+        if (m_stopping)
+            break;
+
+        OperationEntry entry;
+        {
+            osal::ScopedLock lock(m_mutex);
+            entry = m_operations.front();
+            m_operations.pop_front();
+        }
+
+        entry.operation->execute();
+
+        {
+            osal::ScopedLock lock(m_mutex);
+            m_completed.push_back(entry.handle);
+        }
+
+        m_completedSignal.signal();
+    }
+}
+
+} // namespace hal::async
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/uart/FrameReader.hpp"
+
+#include "hal/Error.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace hal::uart {
+
+namespace {
+
+constexpr std::uint8_t cSlipEnd = 0xc0;
+constexpr std::uint8_t cSlipEsc = 0xdb;
+constexpr std::uint8_t cSlipEscEnd = 0xdc;
+constexpr std::uint8_t cSlipEscEsc = 0xdd;
+constexpr std::uint8_t cCobsMaxCode = 0xff;
+
+} // namespace
+
+FrameReader::FrameReader(std::shared_ptr<IUart> uart, std::size_t bufferSize, std::size_t chunkSize)
+    : m_uart(std::move(uart))
+    , m_buffer(std::max<std::size_t>(bufferSize, 1))
+    , m_chunkSize(std::max<std::size_t>(chunkSize, 1))
+{}
+
+Result<std::span<const std::uint8_t>> FrameReader::readUntil(std::uint8_t delimiter, osal::Timeout timeout)
+{
+    auto [frame, error] = next(delimiter, timeout);
+    if (error)
+        return error;
+
+    return std::span<const std::uint8_t>(*frame);
+}
+
+Result<std::span<const std::uint8_t>>
+FrameReader::readLengthPrefixed(std::size_t prefixSize, std::endian byteOrder, osal::Timeout timeout)
+{
+    if (prefixSize == 0 || prefixSize > sizeof(std::uint32_t))
+        return Error::eInvalidArgument;
+
+    if (auto error = require(prefixSize, timeout))
+        return error;
+
+    const auto* prefix = m_buffer.data() + m_begin;
+    std::size_t length{};
+    for (std::size_t i = 0; i < prefixSize; ++i) {
+        auto index = (byteOrder == std::endian::big) ? i : (prefixSize - 1 - i);
+        length = (length << 8) | prefix[index]; // NOLINT
+    }
+
+    if (length > m_buffer.size() - prefixSize) {
+        reset();
+        return Error::eNoMemory;
+    }
+
+    // Partially received frame stays buffered, so that the next call parses the same prefix again.
+    if (auto error = require(prefixSize + length, timeout))
+        return error;
+
+    std::span<const std::uint8_t> frame(m_buffer.data() + m_begin + prefixSize, length);
+    m_begin += prefixSize + length;
+    m_scanned = m_begin;
+    return frame;
+}
+
+Result<std::span<const std::uint8_t>> FrameReader::readCobs(osal::Timeout timeout)
+{
+    while (true) {
+        auto [frame, error] = next(0, timeout);
+        if (error)
+            return error;
+
+        if (frame->empty())
+            continue;
+
+        auto [size, decodeError] = decodeCobs(frame->data(), frame->size());
+        if (decodeError)
+            return decodeError;
+
+        return std::span<const std::uint8_t>(frame->data(), *size);
+    }
+}
+
+Result<std::span<const std::uint8_t>> FrameReader::readSlip(osal::Timeout timeout)
+{
+    while (true) {
+        auto [frame, error] = next(cSlipEnd, timeout);
+        if (error)
+            return error;
+
+        if (frame->empty())
+            continue;
+
+        auto [size, decodeError] = decodeSlip(frame->data(), frame->size());
+        if (decodeError)
+            return decodeError;
+
+        return std::span<const std::uint8_t>(frame->data(), *size);
+    }
+}
+
+void FrameReader::reset()
+{
+    m_begin = 0;
+    m_end = 0;
+    m_scanned = 0;
+}
+
+Result<std::span<std::uint8_t>> FrameReader::next(std::uint8_t delimiter, osal::Timeout timeout)
+{
+    // Bytes scanned for a different delimiter have to be scanned again.
+    if (delimiter != m_delimiter) {
+        m_delimiter = delimiter;
+        m_scanned = m_begin;
+    }
+
+    while (true) {
+        auto* data = m_buffer.data();
+        if (const auto* found = std::memchr(data + m_scanned, delimiter, m_end - m_scanned)) {
+            auto position = static_cast<std::size_t>(static_cast<const std::uint8_t*>(found) - data);
+            std::span<std::uint8_t> frame(data + m_begin, position - m_begin);
+            m_begin = position + 1;
+            m_scanned = m_begin;
+            return frame;
+        }
+
+        m_scanned = m_end;
+        if (auto error = fill(timeout)) {
+            if (error == Error::eNoMemory)
+                reset();
+
+            return error;
+        }
+    }
+}
+
+std::error_code FrameReader::require(std::size_t size, osal::Timeout timeout)
+{
+    while (m_end - m_begin < size) {
+        if (auto error = fill(timeout))
+            return error;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code FrameReader::fill(osal::Timeout timeout)
+{
+    if (m_begin == m_end)
+        reset();
+
+    // Buffer is compacted only when its tail is exhausted, so that the cost of the move is amortized over many frames.
+    if (m_end == m_buffer.size()) {
+        if (m_begin == 0)
+            return Error::eNoMemory;
+
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_scanned -= m_begin;
+        m_begin = 0;
+    }
+
+    auto size = std::min(m_chunkSize, m_buffer.size() - m_end);
+    auto [actualSize, error] = m_uart->read(m_buffer.data() + m_end, size, timeout);
+    if (error)
+        return error;
+
+    if (*actualSize == 0)
+        return Error::eTimeout;
+
+    m_end += *actualSize;
+    return Error::eOk;
+}
+
+Result<std::size_t> FrameReader::decodeCobs(std::uint8_t* bytes, std::size_t size)
+{
+    std::size_t readIndex{};
+    std::size_t writeIndex{};
+
+    while (readIndex < size) {
+        auto code = bytes[readIndex++];
+        if (code == 0)
+            return Error::eFrameError;
+
+        std::size_t blockSize = code - 1;
+        if (readIndex + blockSize > size)
+            return Error::eFrameError;
+
+        std::memmove(bytes + writeIndex, bytes + readIndex, blockSize);
+        readIndex += blockSize;
+        writeIndex += blockSize;
+
+        // Each block, but the maximal one, is followed by the zero byte, which is implicit at the end of the frame.
+        if (code != cCobsMaxCode && readIndex < size)
+            bytes[writeIndex++] = 0;
+    }
+
+    return writeIndex;
+}
+
+Result<std::size_t> FrameReader::decodeSlip(std::uint8_t* bytes, std::size_t size)
+{
+    std::size_t writeIndex{};
+
+    for (std::size_t readIndex = 0; readIndex < size; ++readIndex) {
+        auto byte = bytes[readIndex];
+        if (byte == cSlipEsc) {
+            if (++readIndex == size)
+                return Error::eFrameError;
+
+            switch (bytes[readIndex]) {
+                case cSlipEscEnd: byte = cSlipEnd; break;
+                case cSlipEscEsc: byte = cSlipEsc; break;
+                default: return Error::eFrameError;
+            }
+        }
+
+        bytes[writeIndex++] = byte;
+    }
+
+    return writeIndex;
+}
+
+} // namespace hal::uart
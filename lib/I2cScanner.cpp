@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/i2c/I2cScanner.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <osal/Timeout.hpp>
+
+#include <utility>
+
+namespace hal::i2c {
+
+/// Checks if the given address is reserved by the I2C specification in the given addressing mode.
+/// @param addressingMode   Addressing mode to be checked.
+/// @param address          Address to be checked.
+/// @return Flag indicating if the given address is reserved.
+static bool isReserved(AddressingMode addressingMode, std::uint16_t address)
+{
+    constexpr std::uint16_t cFirstValid7bit = 0x08;
+    constexpr std::uint16_t cLastValid7bit = 0x77;
+
+    if (addressingMode != AddressingMode::e7bit)
+        return false;
+
+    return (address < cFirstValid7bit || address > cLastValid7bit);
+}
+
+I2cScanner::I2cScanner(std::shared_ptr<II2c> i2c)
+    : m_i2c(std::move(i2c))
+{}
+
+std::error_code I2cScanner::scan(std::chrono::milliseconds probeTimeout)
+{
+    m_present.reset();
+    m_valid = false;
+    m_addressingMode = m_i2c->params().addressingMode;
+
+    for (std::uint16_t address = 0; address < m_cMaxAddresses; ++address) {
+        if (!verifyAddress(m_addressingMode, address))
+            break;
+
+        if (isReserved(m_addressingMode, address))
+            continue;
+
+        auto error = m_i2c->probe(address, osal::Timeout(probeTimeout));
+        if (error == Error::eWrongState || error == Error::eDeviceNotOpened) {
+            I2cLogger::error("Failed to scan: invalid state err={}", error.message());
+            return error;
+        }
+
+        m_present[address] = !error;
+    }
+
+    m_valid = true;
+    I2cLogger::info("Bus scanned: found {} devices", m_present.count());
+    return Error::eOk;
+}
+
+bool I2cScanner::rescan(std::uint16_t address, std::chrono::milliseconds probeTimeout)
+{
+    auto addressingMode = m_i2c->params().addressingMode;
+    if (addressingMode != m_addressingMode) {
+        clear();
+        m_addressingMode = addressingMode;
+    }
+
+    if (!verifyAddress(m_addressingMode, address))
+        return false;
+
+    m_present[address] = !m_i2c->probe(address, osal::Timeout(probeTimeout));
+    return m_present[address];
+}
+
+bool I2cScanner::isPresent(std::uint16_t address) const
+{
+    if (!isValid() || !verifyAddress(m_addressingMode, address))
+        return false;
+
+    return m_present[address];
+}
+
+std::vector<std::uint16_t> I2cScanner::devices() const
+{
+    std::vector<std::uint16_t> result;
+    if (!isValid())
+        return result;
+
+    for (std::uint16_t address = 0; address < m_cMaxAddresses; ++address) {
+        if (m_present[address])
+            result.push_back(address);
+    }
+
+    return result;
+}
+
+void I2cScanner::clear()
+{
+    m_present.reset();
+    m_valid = false;
+}
+
+BytesVector I2cScanner::serialize() const
+{
+    constexpr std::size_t cBitsPerByte = 8;
+
+    BytesVector bytes{m_cFormatVersion, static_cast<std::uint8_t>(m_addressingMode)};
+    bytes.resize(bytes.size() + m_cMaxAddresses / cBitsPerByte);
+
+    for (std::size_t address = 0; address < m_cMaxAddresses; ++address) {
+        if (m_present[address])
+            bytes[2 + address / cBitsPerByte] |= static_cast<std::uint8_t>(1U << (address % cBitsPerByte));
+    }
+
+    return bytes;
+}
+
+std::error_code I2cScanner::deserialize(std::span<const std::uint8_t> bytes)
+{
+    constexpr std::size_t cBitsPerByte = 8;
+    constexpr std::size_t cSerializedSize = 2 + m_cMaxAddresses / cBitsPerByte;
+
+    auto addressingMode = m_i2c->params().addressingMode;
+    if (bytes.size() != cSerializedSize || bytes[0] != m_cFormatVersion
+        || bytes[1] != static_cast<std::uint8_t>(addressingMode)) {
+        I2cLogger::error("Failed to deserialize presence map: invalid format");
+        return Error::eInvalidArgument;
+    }
+
+    m_addressingMode = addressingMode;
+
+    for (std::size_t address = 0; address < m_cMaxAddresses; ++address)
+        m_present[address] = ((bytes[2 + address / cBitsPerByte] >> (address % cBitsPerByte)) & 1U) != 0;
+
+    m_valid = true;
+    return Error::eOk;
+}
+
+} // namespace hal::i2c
@@ -62,6 +62,11 @@ IEeprom::write(std::uint32_t address, const std::uint8_t* bytes, std::size_t siz
     return drvWrite(address, bytes, size, timeout);
 }
 
+std::error_code IEeprom::write(std::uint32_t address, std::span<const std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return write(address, bytes.data(), bytes.size(), timeout);
+}
+
 Result<BytesVector> IEeprom::read(std::uint32_t address, std::size_t size, osal::Timeout timeout)
 {
     BytesVector bytes(size);
@@ -76,6 +81,21 @@ Result<BytesVector> IEeprom::read(std::uint32_t address, std::size_t size, osal:
     return bytes;
 }
 
+Result<PooledBytesVector>
+IEeprom::read(std::uint32_t address, std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout)
+{
+    PooledBytesVector bytes(size, &resource);
+    if (bytes.size() != size)
+        return Error::eNoMemory;
+
+    auto [actualReadSize, error] = read(address, bytes.data(), size, timeout);
+    if (error)
+        return error;
+
+    bytes.resize(*actualReadSize);
+    return bytes;
+}
+
 Result<std::size_t> IEeprom::read(std::uint32_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
 {
     if ((address + size) > getSize())
@@ -87,4 +107,9 @@ Result<std::size_t> IEeprom::read(std::uint32_t address, std::uint8_t* bytes, st
     return drvRead(address, bytes, size, timeout);
 }
 
+Result<std::size_t> IEeprom::read(std::uint32_t address, std::span<std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return read(address, bytes.data(), bytes.size(), timeout);
+}
+
 } // namespace hal::storage
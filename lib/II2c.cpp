@@ -35,6 +35,10 @@
 #include "hal/Error.hpp"
 #include "hal/logger/interfaces.hpp"
 
+#include <osal/sleep.hpp>
+
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <utility>
 
@@ -57,11 +61,19 @@ bool verifyAddress(AddressingMode addressingMode, std::uint16_t address)
 
 II2c::II2c(II2c&& other) noexcept
     : m_mutex(std::move(other.m_mutex))
-{}
+{
+    std::swap(m_userCount, other.m_userCount);
+    std::swap(m_opened, other.m_opened);
+    m_owner.takeOver(other.m_owner);
+    std::swap(m_params, other.m_params);
+    std::swap(m_retryPolicy, other.m_retryPolicy);
+    std::swap(m_tracer, other.m_tracer);
+    std::swap(m_arbiter, other.m_arbiter);
+}
 
 II2c::~II2c()
 {
-    assert(m_userCount == 0 && !m_locked);
+    assert(m_userCount == 0 && !m_owner.isOwned());
 }
 
 std::error_code II2c::open()
@@ -106,17 +118,58 @@ std::error_code II2c::close()
     return Error::eOk;
 }
 
-std::error_code II2c::lock(osal::Timeout timeout)
+std::error_code II2c::setParams(I2cParams params)
+{
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to set params: invalid state err={}", error.message());
+        return error;
+    }
+
+    if (auto error = drvSetParams(params))
+        return error;
+
+    m_params = params;
+    return Error::eOk;
+}
+
+std::error_code II2c::recoverBus(osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to recover bus: invalid state err={}", error.message());
+        return error;
+    }
+
+    I2cLogger::warn("Performing bus recovery");
+    return drvRecoverBus(timeout);
+}
+
+std::error_code II2c::lock(osal::Timeout timeout, BusPriority priority)
 {
     if (!isLocked()) {
+        auto start = m_tracer ? TransferTracer::Clock::now() : TransferTracer::Clock::time_point{};
+        if (m_arbiter) {
+            if (auto error = m_arbiter->acquire(priority, timeout)) {
+                I2cLogger::warn("Failed to acquire I2C bus from arbiter: err={} (timeout={} ms)",
+                                error.message(),
+                                osal::durationMs(timeout));
+                return error;
+            }
+        }
+
         if (auto error = m_mutex.timedLock(timeout)) {
+            if (m_arbiter)
+                m_arbiter->release();
+
             I2cLogger::warn("Failed to lock I2C bus: err={} (timeout={} ms)",
                             error.message(),
                             osal::durationMs(timeout));
             return error;
         }
 
-        m_locked = true;
+        if (m_tracer)
+            m_tracer->recordLockWait(TransferTracer::Clock::now() - start);
+
+        m_owner.acquire();
 
         I2cLogger::trace("Bus successfully locked");
         return Error::eOk;
@@ -133,7 +186,7 @@ std::error_code II2c::unlock()
         return Error::eWrongState;
     }
 
-    m_locked = false;
+    m_owner.release();
 
     if (auto error = m_mutex.unlock()) {
         I2cLogger::critical("Failed to unlock I2C bus: mutex error");
@@ -141,6 +194,9 @@ std::error_code II2c::unlock()
         return error;
     }
 
+    if (m_arbiter)
+        m_arbiter->release();
+
     I2cLogger::trace("Bus successfully unlocked");
     return Error::eOk;
 }
@@ -163,7 +219,27 @@ II2c::write(std::uint16_t address, const std::uint8_t* bytes, std::size_t size,
         return error;
     }
 
-    return drvWrite(address, bytes, size, stop, timeout);
+    return TransferTracer::trace(m_tracer.get(), address, TransferType::eWrite, size, [&] {
+        return withRetry([&] { return drvWrite(address, bytes, size, stop, timeout); }, timeout);
+    });
+}
+
+std::error_code
+II2c::write(std::uint16_t address, std::span<const std::uint8_t> bytes, bool stop, osal::Timeout timeout)
+{
+    return write(address, bytes.data(), bytes.size(), stop, timeout);
+}
+
+std::error_code II2c::write(std::uint16_t address, const DmaBuffer& buffer, bool stop, osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to write: invalid state err={}", error.message());
+        return error;
+    }
+
+    return TransferTracer::trace(m_tracer.get(), address, TransferType::eWrite, buffer.size(), [&] {
+        return withRetry([&] { return drvWriteDma(address, buffer, stop, timeout); }, timeout);
+    });
 }
 
 Result<BytesVector> II2c::read(std::uint16_t address, std::size_t size, osal::Timeout timeout)
@@ -184,6 +260,25 @@ Result<BytesVector> II2c::read(std::uint16_t address, std::size_t size, osal::Ti
     return bytes;
 }
 
+Result<PooledBytesVector>
+II2c::read(std::uint16_t address, std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout)
+{
+    PooledBytesVector bytes(size, &resource);
+    if (bytes.size() != size) {
+        I2cLogger::error("Failed to read: cannot resize output vector");
+        return Error::eNoMemory;
+    }
+
+    auto [actualReadSize, error] = read(address, bytes.data(), size, timeout);
+    if (error) {
+        I2cLogger::error("Failed to read: err={}", error.message());
+        return error;
+    }
+
+    bytes.resize(*actualReadSize);
+    return bytes;
+}
+
 Result<std::size_t> II2c::read(std::uint16_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
 {
     if (bytes == nullptr) {
@@ -196,20 +291,204 @@ Result<std::size_t> II2c::read(std::uint16_t address, std::uint8_t* bytes, std::
         return error;
     }
 
-    return drvRead(address, bytes, size, timeout);
+    std::size_t actualReadSize{};
+    auto error = TransferTracer::trace(m_tracer.get(), address, TransferType::eRead, size, [&] {
+        return withRetry(
+            [&] {
+                auto [readSize, readError] = drvRead(address, bytes, size, timeout);
+                if (!readError)
+                    actualReadSize = *readSize;
+
+                return readError;
+            },
+            timeout);
+    });
+
+    if (error)
+        return error;
+
+    return actualReadSize;
+}
+
+Result<std::size_t> II2c::read(std::uint16_t address, std::span<std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return read(address, bytes.data(), bytes.size(), timeout);
+}
+
+Result<std::size_t> II2c::read(std::uint16_t address, DmaBuffer& buffer, osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to read: invalid state err={}", error.message());
+        return error;
+    }
+
+    std::size_t actualReadSize{};
+    auto error = TransferTracer::trace(m_tracer.get(), address, TransferType::eRead, buffer.size(), [&] {
+        return withRetry(
+            [&] {
+                auto [readSize, readError] = drvReadDma(address, buffer, timeout);
+                if (!readError)
+                    actualReadSize = *readSize;
+
+                return readError;
+            },
+            timeout);
+    });
+
+    if (error)
+        return error;
+
+    return actualReadSize;
 }
 
-bool II2c::isLocked()
+Result<BytesVector>
+II2c::writeRead(std::uint16_t address, const BytesVector& txBytes, std::size_t rxSize, osal::Timeout timeout)
 {
-    if (auto error = m_mutex.tryLock()) {
-        I2cLogger::trace("isLocked(): Failed to lock the mutex, err={}", error.message());
-        return false;
+    BytesVector rxBytes(rxSize);
+    if (rxBytes.size() != rxSize) {
+        I2cLogger::error("Failed to writeRead: cannot resize output vector");
+        return Error::eNoMemory;
     }
 
-    bool result = m_locked;
-    m_mutex.unlock();
+    auto [actualReadSize, error] = writeRead(address, txBytes.data(), txBytes.size(), rxBytes.data(), rxSize, timeout);
+    if (error) {
+        I2cLogger::error("Failed to writeRead: err={}", error.message());
+        return error;
+    }
 
-    return result;
+    rxBytes.resize(*actualReadSize);
+    return rxBytes;
+}
+
+Result<std::size_t> II2c::writeRead(std::uint16_t address,
+                                    const std::uint8_t* txBytes,
+                                    std::size_t txSize,
+                                    std::uint8_t* rxBytes,
+                                    std::size_t rxSize,
+                                    osal::Timeout timeout)
+{
+    const std::array<I2cMessage, 2> cMessages{
+        {{address, txBytes, nullptr, txSize}, {address, nullptr, rxBytes, rxSize}}
+    };
+
+    if (auto error = transfer(cMessages.data(), cMessages.size(), timeout))
+        return error;
+
+    return rxSize;
+}
+
+Result<std::size_t> II2c::writeRead(std::uint16_t address,
+                                    std::span<const std::uint8_t> txBytes,
+                                    std::span<std::uint8_t> rxBytes,
+                                    osal::Timeout timeout)
+{
+    return writeRead(address, txBytes.data(), txBytes.size(), rxBytes.data(), rxBytes.size(), timeout);
+}
+
+std::error_code II2c::transfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout)
+{
+    if (messages == nullptr || count == 0) {
+        I2cLogger::error("Failed to transfer: messages={}, count={}", fmt::ptr(messages), count);
+        return Error::eInvalidArgument;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& message = messages[i];
+        if ((message.txBytes == nullptr) == (message.rxBytes == nullptr)) {
+            I2cLogger::error("Failed to transfer: message {} has txBytes={}, rxBytes={}",
+                             i,
+                             fmt::ptr(message.txBytes),
+                             fmt::ptr(message.rxBytes));
+            return Error::eInvalidArgument;
+        }
+    }
+
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to transfer: invalid state err={}", error.message());
+        return error;
+    }
+
+    std::size_t size{};
+    for (std::size_t i = 0; i < count; ++i)
+        size += messages[i].size;
+
+    return TransferTracer::trace(m_tracer.get(), messages[0].address, TransferType::eTransfer, size, [&] {
+        return withRetry([&] { return drvTransfer(messages, count, timeout); }, timeout);
+    });
+}
+
+std::error_code II2c::transfer(std::span<const I2cMessage> messages, osal::Timeout timeout)
+{
+    return transfer(messages.data(), messages.size(), timeout);
+}
+
+std::error_code II2c::drvSetParams(I2cParams /*params*/)
+{
+    return Error::eNotSupported;
+}
+
+std::error_code II2c::drvWriteDma(std::uint16_t address, const DmaBuffer& buffer, bool stop, osal::Timeout timeout)
+{
+    return drvWrite(address, buffer.data(), buffer.size(), stop, timeout);
+}
+
+Result<std::size_t> II2c::drvReadDma(std::uint16_t address, DmaBuffer& buffer, osal::Timeout timeout)
+{
+    return drvRead(address, buffer.data(), buffer.size(), timeout);
+}
+
+std::error_code II2c::drvTransfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& message = messages[i];
+        bool stop = (i == (count - 1));
+
+        if (message.txBytes != nullptr) {
+            if (auto error = drvWrite(message.address, message.txBytes, message.size, stop, timeout))
+                return error;
+
+            continue;
+        }
+
+        auto [actualReadSize, error] = drvRead(message.address, message.rxBytes, message.size, timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != message.size) {
+            I2cLogger::error("Failed to transfer: short read in message {} ({}/{} bytes)",
+                             i,
+                             *actualReadSize,
+                             message.size);
+            return Error::eHardwareError;
+        }
+    }
+
+    return Error::eOk;
+}
+
+std::error_code II2c::probe(std::uint16_t address, osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        I2cLogger::error("Failed to probe: invalid state err={}", error.message());
+        return error;
+    }
+
+    return drvProbe(address, timeout);
+}
+
+std::error_code II2c::drvProbe(std::uint16_t address, osal::Timeout timeout)
+{
+    std::uint8_t byte{};
+    auto [actualReadSize, error] = drvRead(address, &byte, sizeof(byte), timeout);
+    if (error)
+        return error;
+
+    return (*actualReadSize == sizeof(byte)) ? Error::eOk : Error::eHardwareError;
+}
+
+std::error_code II2c::drvRecoverBus(osal::Timeout /*timeout*/)
+{
+    return Error::eNotSupported;
 }
 
 std::error_code II2c::checkState()
@@ -227,4 +506,35 @@ std::error_code II2c::checkState()
     return Error::eOk;
 }
 
+template <typename Operation>
+std::error_code II2c::withRetry(Operation operation, osal::Timeout timeout)
+{
+    auto backoff = m_retryPolicy.initialBackoff;
+
+    for (std::uint32_t attempt = 1;; ++attempt) {
+        auto error = operation();
+        if (!error || attempt >= m_retryPolicy.maxAttempts || timeout.isExpired())
+            return error;
+
+        bool retry = (error == Error::eArbitrationLost) || (error == Error::eNack && m_retryPolicy.retryOnNack);
+        if (!retry && m_retryPolicy.recoverBus && (error == Error::eTimeout || error == Error::eHardwareError)) {
+            I2cLogger::warn("Transfer failed: err={}, performing bus recovery", error.message());
+            retry = !drvRecoverBus(timeout);
+        }
+
+        if (!retry)
+            return error;
+
+        I2cLogger::info("Retrying transfer: err={}, attempt={}/{}",
+                        error.message(),
+                        attempt,
+                        m_retryPolicy.maxAttempts);
+
+        if (backoff.count() > 0) {
+            osal::sleep(backoff);
+            backoff = std::max(m_retryPolicy.initialBackoff, std::min(backoff * 2, m_retryPolicy.maxBackoff));
+        }
+    }
+}
+
 } // namespace hal::i2c
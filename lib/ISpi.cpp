@@ -35,22 +35,41 @@
 #include "hal/Error.hpp"
 #include "hal/logger/interfaces.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <utility>
 
 namespace hal::spi {
 
+namespace {
+
+/// Checks if both sets of parameters result in the same transmission, i.e. if they differ at most in deviceId.
+/// @param lhs              First set of parameters.
+/// @param rhs              Second set of parameters.
+/// @return Flag indicating if both sets of parameters result in the same transmission.
+bool isSameTransmission(SpiParams lhs, const SpiParams& rhs)
+{
+    lhs.deviceId = rhs.deviceId;
+    return lhs == rhs;
+}
+
+} // namespace
+
 ISpi::ISpi(ISpi&& other) noexcept
     : m_mutex(std::move(other.m_mutex))
 {
     std::swap(m_userCount, other.m_userCount);
     std::swap(m_opened, other.m_opened);
-    std::swap(m_locked, other.m_locked);
+    m_owner.takeOver(other.m_owner);
+    std::swap(m_tracer, other.m_tracer);
+    std::swap(m_params, other.m_params);
+    std::swap(m_arbiter, other.m_arbiter);
 }
 
 ISpi::~ISpi()
 {
-    assert(m_userCount == 0 && !m_locked);
+    assert(m_userCount == 0 && !m_owner.isOwned());
 }
 
 std::error_code ISpi::open()
@@ -67,6 +86,7 @@ std::error_code ISpi::open()
         return Error::eDeviceOpened;
     }
 
+    m_params.reset();
     auto error = drvOpen();
     m_opened = !error;
     return error;
@@ -86,6 +106,7 @@ std::error_code ISpi::close()
 
     --m_userCount;
     if (m_userCount == 0) {
+        m_params.reset();
         auto error = drvClose();
         m_opened = static_cast<bool>(error);
         return error;
@@ -102,20 +123,48 @@ std::error_code ISpi::setParams(SpiParams params)
         return error;
     }
 
-    return drvSetParams(params);
+    if (m_params && isSameTransmission(*m_params, params)) {
+        SpiLogger::trace("Skipping set params: parameters are already set");
+        m_params = params;
+        return Error::eOk;
+    }
+
+    if (auto error = drvSetParams(params)) {
+        m_params.reset();
+        return error;
+    }
+
+    m_params = params;
+    return Error::eOk;
 }
 
-std::error_code ISpi::lock(osal::Timeout timeout)
+std::error_code ISpi::lock(osal::Timeout timeout, BusPriority priority)
 {
     if (!isLocked()) {
+        auto start = m_tracer ? TransferTracer::Clock::now() : TransferTracer::Clock::time_point{};
+        if (m_arbiter) {
+            if (auto error = m_arbiter->acquire(priority, timeout)) {
+                SpiLogger::warn("Failed to acquire SPI bus from arbiter: err={} (timeout={} ms)",
+                                error.message(),
+                                osal::durationMs(timeout));
+                return error;
+            }
+        }
+
         if (auto error = m_mutex.timedLock(timeout)) {
+            if (m_arbiter)
+                m_arbiter->release();
+
             SpiLogger::warn("Failed to lock SPI bus: err={} (timeout={} ms)",
                             error.message(),
                             osal::durationMs(timeout));
             return error;
         }
 
-        m_locked = true;
+        if (m_tracer)
+            m_tracer->recordLockWait(TransferTracer::Clock::now() - start);
+
+        m_owner.acquire();
 
         SpiLogger::trace("Bus successfully locked");
         return Error::eOk;
@@ -132,7 +181,7 @@ std::error_code ISpi::unlock()
         return Error::eWrongState;
     }
 
-    m_locked = false;
+    m_owner.release();
 
     if (auto error = m_mutex.unlock()) {
         SpiLogger::critical("Failed to unlock SPI bus: mutex error (err={})", error.message());
@@ -140,6 +189,9 @@ std::error_code ISpi::unlock()
         return error;
     }
 
+    if (m_arbiter)
+        m_arbiter->release();
+
     SpiLogger::trace("Bus successfully unlocked");
     return Error::eOk;
 }
@@ -161,7 +213,26 @@ std::error_code ISpi::write(const std::uint8_t* bytes, std::size_t size, osal::T
         return error;
     }
 
-    return drvWrite(bytes, size, timeout);
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eWrite, size, [&] {
+        return drvWrite(bytes, size, timeout);
+    });
+}
+
+std::error_code ISpi::write(std::span<const std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return write(bytes.data(), bytes.size(), timeout);
+}
+
+std::error_code ISpi::write(const DmaBuffer& buffer, osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to write: invalid state err={}", error.message());
+        return error;
+    }
+
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eWrite, buffer.size(), [&] {
+        return drvWriteDma(buffer, timeout);
+    });
 }
 
 Result<BytesVector> ISpi::read(std::size_t size, osal::Timeout timeout)
@@ -182,6 +253,24 @@ Result<BytesVector> ISpi::read(std::size_t size, osal::Timeout timeout)
     return bytes;
 }
 
+Result<PooledBytesVector> ISpi::read(std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout)
+{
+    PooledBytesVector bytes(size, &resource);
+    if (bytes.size() != size) {
+        SpiLogger::error("Failed to read: cannot resize output vector");
+        return Error::eNoMemory;
+    }
+
+    auto [actualReadSize, error] = read(bytes.data(), size, timeout);
+    if (error) {
+        SpiLogger::error("Failed to read: err={}", error.message());
+        return error;
+    }
+
+    bytes.resize(*actualReadSize);
+    return bytes;
+}
+
 Result<std::size_t> ISpi::read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
 {
     if (auto error = checkState()) {
@@ -189,7 +278,26 @@ Result<std::size_t> ISpi::read(std::uint8_t* bytes, std::size_t size, osal::Time
         return error;
     }
 
-    return drvRead(bytes, size, timeout);
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eRead, size, [&] {
+        return drvRead(bytes, size, timeout);
+    });
+}
+
+Result<std::size_t> ISpi::read(std::span<std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return read(bytes.data(), bytes.size(), timeout);
+}
+
+Result<std::size_t> ISpi::read(DmaBuffer& buffer, osal::Timeout timeout)
+{
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to read: invalid state err={}", error.message());
+        return error;
+    }
+
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eRead, buffer.size(), [&] {
+        return drvReadDma(buffer, timeout);
+    });
 }
 
 Result<BytesVector> ISpi::transfer(const BytesVector& txBytes, osal::Timeout timeout)
@@ -208,6 +316,23 @@ Result<BytesVector> ISpi::transfer(const BytesVector& txBytes, osal::Timeout tim
     return rxBytes;
 }
 
+Result<PooledBytesVector>
+ISpi::transfer(std::span<const std::uint8_t> txBytes, std::pmr::memory_resource& resource, osal::Timeout timeout)
+{
+    PooledBytesVector rxBytes(txBytes.size(), &resource);
+    if (rxBytes.size() != txBytes.size()) {
+        SpiLogger::error("Failed to transfer: cannot resize output vector");
+        return Error::eNoMemory;
+    }
+
+    auto [actualReadSize, error] = transfer(txBytes.data(), rxBytes.data(), txBytes.size(), timeout);
+    if (error)
+        return error;
+
+    rxBytes.resize(*actualReadSize);
+    return rxBytes;
+}
+
 Result<std::size_t>
 ISpi::transfer(const std::uint8_t* txBytes, std::uint8_t* rxBytes, std::size_t size, osal::Timeout timeout)
 {
@@ -221,19 +346,220 @@ ISpi::transfer(const std::uint8_t* txBytes, std::uint8_t* rxBytes, std::size_t s
         return error;
     }
 
-    return drvTransfer(txBytes, rxBytes, size, timeout);
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eTransfer, size, [&] {
+        return drvTransfer(txBytes, rxBytes, size, timeout);
+    });
+}
+
+Result<std::size_t>
+ISpi::transfer(std::span<const std::uint8_t> txBytes, std::span<std::uint8_t> rxBytes, osal::Timeout timeout)
+{
+    if (txBytes.size() != rxBytes.size()) {
+        SpiLogger::error("Failed to transfer: txSize={}, rxSize={}", txBytes.size(), rxBytes.size());
+        return Error::eInvalidArgument;
+    }
+
+    return transfer(txBytes.data(), rxBytes.data(), txBytes.size(), timeout);
+}
+
+Result<std::size_t> ISpi::transfer(const DmaBuffer& txBuffer, DmaBuffer& rxBuffer, osal::Timeout timeout)
+{
+    if (txBuffer.size() != rxBuffer.size()) {
+        SpiLogger::error("Failed to transfer: txSize={}, rxSize={}", txBuffer.size(), rxBuffer.size());
+        return Error::eInvalidArgument;
+    }
+
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to transfer: invalid state err={}", error.message());
+        return error;
+    }
+
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eTransfer, txBuffer.size(), [&] {
+        return drvTransferDma(txBuffer, rxBuffer, timeout);
+    });
+}
+
+std::error_code ISpi::transfer(const SpiSegment* segments, std::size_t count, osal::Timeout timeout)
+{
+    if (segments == nullptr || count == 0) {
+        SpiLogger::error("Failed to transfer: segments={}, count={}", fmt::ptr(segments), count);
+        return Error::eInvalidArgument;
+    }
+
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to transfer: invalid state err={}", error.message());
+        return error;
+    }
+
+    std::size_t size{};
+    for (std::size_t i = 0; i < count; ++i)
+        size += segments[i].size;
+
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eTransfer, size, [&] {
+        return drvTransferList(segments, count, timeout);
+    });
+}
+
+std::error_code ISpi::transfer(std::span<const SpiSegment> segments, osal::Timeout timeout)
+{
+    return transfer(segments.data(), segments.size(), timeout);
+}
+
+std::error_code ISpi::memOp(const SpiMemOp& operation, osal::Timeout timeout)
+{
+    constexpr std::uint8_t cMaxAddressSize = 4;
+
+    bool noData = (operation.txData == nullptr) && (operation.rxData == nullptr);
+    if (operation.addressSize > cMaxAddressSize || (operation.dataSize != 0 && noData)) {
+        SpiLogger::error("Failed to perform memory operation: addressSize={}, dataSize={}",
+                         operation.addressSize,
+                         operation.dataSize);
+        return Error::eInvalidArgument;
+    }
+
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to perform memory operation: invalid state err={}", error.message());
+        return error;
+    }
+
+    auto size = 1 + operation.addressSize + operation.dummySize + operation.dataSize;
+    return TransferTracer::trace(m_tracer.get(), deviceId(), TransferType::eTransfer, size, [&] {
+        return drvMemOp(operation, timeout);
+    });
 }
 
-bool ISpi::isLocked()
+std::error_code ISpi::startStream(const SpiStreamRing& ring, StreamCallback callback)
 {
-    if (auto error = m_mutex.tryLock()) {
-        SpiLogger::trace("isLocked(): Failed to lock the mutex (err={})", error.message());
-        return false;
+    if (ring.frames == nullptr || ring.frameSize == 0 || ring.frameStride < ring.frameSize || ring.frameCount == 0
+        || ring.firstFrame >= ring.frameCount || !callback) {
+        SpiLogger::error("Failed to start stream: frames={}, frameSize={}, frameStride={}, frameCount={}",
+                         fmt::ptr(ring.frames),
+                         ring.frameSize,
+                         ring.frameStride,
+                         ring.frameCount);
+        return Error::eInvalidArgument;
     }
 
-    bool result = m_locked;
-    m_mutex.unlock();
-    return result;
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to start stream: invalid state err={}", error.message());
+        return error;
+    }
+
+    return drvStartStream(ring, std::move(callback));
+}
+
+std::error_code ISpi::stopStream()
+{
+    if (auto error = checkState()) {
+        SpiLogger::error("Failed to stop stream: invalid state err={}", error.message());
+        return error;
+    }
+
+    return drvStopStream();
+}
+
+std::error_code ISpi::drvTransferList(const SpiSegment* segments, std::size_t count, osal::Timeout timeout)
+{
+    constexpr std::size_t cDummySize = 32;
+    static constexpr std::array<std::uint8_t, cDummySize> cDummyBytes{};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& segment = segments[i];
+        bool last = (i + 1) == count;
+        if ((segment.csChange && !last) || segment.speedHz != 0 || segment.txWidth != BusWidth::eSingle
+            || segment.rxWidth != BusWidth::eSingle) {
+            SpiLogger::error("Failed to transfer: segment {} requires csChange, speedHz or bus width support", i);
+            return Error::eNotSupported;
+        }
+
+        if (segment.txBytes != nullptr && segment.rxBytes != nullptr) {
+            auto [actualSize, error] = drvTransfer(segment.txBytes, segment.rxBytes, segment.size, timeout);
+            if (error)
+                return error;
+
+            if (*actualSize != segment.size)
+                return Error::eHardwareError;
+        }
+        else if (segment.rxBytes != nullptr) {
+            auto [actualSize, error] = drvRead(segment.rxBytes, segment.size, timeout);
+            if (error)
+                return error;
+
+            if (*actualSize != segment.size)
+                return Error::eHardwareError;
+        }
+        else if (segment.txBytes != nullptr) {
+            if (auto error = drvWrite(segment.txBytes, segment.size, timeout))
+                return error;
+        }
+        else {
+            for (std::size_t offset = 0; offset < segment.size; offset += cDummySize) {
+                auto chunkSize = std::min(segment.size - offset, cDummySize);
+                if (auto error = drvWrite(cDummyBytes.data(), chunkSize, timeout))
+                    return error;
+            }
+        }
+    }
+
+    return Error::eOk;
+}
+
+std::error_code ISpi::drvMemOp(const SpiMemOp& operation, osal::Timeout timeout)
+{
+    constexpr unsigned int cBitsPerByte = 8;
+
+    std::array<std::uint8_t, sizeof(operation.address)> address{};
+    for (std::size_t i = 0; i < operation.addressSize; ++i) {
+        auto shift = (operation.addressSize - 1 - i) * cBitsPerByte;
+        address[i] = static_cast<std::uint8_t>(operation.address >> shift);
+    }
+
+    std::array<SpiSegment, 4> segments{};
+    std::size_t count{};
+    segments[count++] = {&operation.command, nullptr, 1, 0, false, operation.commandWidth};
+
+    if (operation.addressSize != 0)
+        segments[count++] = {address.data(), nullptr, operation.addressSize, 0, false, operation.addressWidth};
+
+    if (operation.dummySize != 0)
+        segments[count++] = {nullptr, nullptr, operation.dummySize, 0, false, operation.dummyWidth};
+
+    if (operation.dataSize != 0) {
+        segments[count++] = {operation.txData,
+                             operation.rxData,
+                             operation.dataSize,
+                             0,
+                             false,
+                             operation.dataWidth,
+                             operation.dataWidth};
+    }
+
+    return drvTransferList(segments.data(), count, timeout);
+}
+
+std::error_code ISpi::drvStartStream(const SpiStreamRing& /*ring*/, StreamCallback /*callback*/)
+{
+    return Error::eNotSupported;
+}
+
+std::error_code ISpi::drvStopStream()
+{
+    return Error::eNotSupported;
+}
+
+std::error_code ISpi::drvWriteDma(const DmaBuffer& buffer, osal::Timeout timeout)
+{
+    return drvWrite(buffer.data(), buffer.size(), timeout);
+}
+
+Result<std::size_t> ISpi::drvReadDma(DmaBuffer& buffer, osal::Timeout timeout)
+{
+    return drvRead(buffer.data(), buffer.size(), timeout);
+}
+
+Result<std::size_t> ISpi::drvTransferDma(const DmaBuffer& txBuffer, DmaBuffer& rxBuffer, osal::Timeout timeout)
+{
+    return drvTransfer(txBuffer.data(), rxBuffer.data(), txBuffer.size(), timeout);
 }
 
 std::error_code ISpi::checkState()
@@ -34,6 +34,8 @@
 
 #include "hal/Error.hpp"
 
+#include <utility>
+
 namespace hal::uart {
 
 std::error_code IUart::open()
@@ -58,28 +60,36 @@ std::error_code IUart::close()
 
 std::error_code IUart::setBaudrate(Baudrate baudrate)
 {
-    if (isOpened())
-        return Error::eDeviceOpened;
+    if (auto error = prepareReconfiguration())
+        return error;
 
     return drvSetBaudrate(baudrate);
 }
 
 std::error_code IUart::setMode(Mode mode)
 {
-    if (isOpened())
-        return Error::eDeviceOpened;
+    if (auto error = prepareReconfiguration())
+        return error;
 
     return drvSetMode(mode);
 }
 
 std::error_code IUart::setFlowControl(FlowControl flowControl)
 {
-    if (isOpened())
-        return Error::eDeviceOpened;
+    if (auto error = prepareReconfiguration())
+        return error;
 
     return drvSetFlowControl(flowControl);
 }
 
+std::error_code IUart::drain()
+{
+    if (!isOpened())
+        return Error::eDeviceNotOpened;
+
+    return drvDrain();
+}
+
 std::error_code IUart::write(const BytesVector& bytes)
 {
     return write(bytes.data(), bytes.size());
@@ -96,6 +106,11 @@ std::error_code IUart::write(const std::uint8_t* bytes, std::size_t size)
     return drvWrite(bytes, size);
 }
 
+std::error_code IUart::write(std::span<const std::uint8_t> bytes)
+{
+    return write(bytes.data(), bytes.size());
+}
+
 Result<BytesVector> IUart::read(std::size_t size, osal::Timeout timeout)
 {
     BytesVector bytes(size);
@@ -110,6 +125,20 @@ Result<BytesVector> IUart::read(std::size_t size, osal::Timeout timeout)
     return bytes;
 }
 
+Result<PooledBytesVector> IUart::read(std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout)
+{
+    PooledBytesVector bytes(size, &resource);
+    if (bytes.size() != size)
+        return Error::eNoMemory;
+
+    auto [actualReadSize, error] = read(bytes.data(), size, timeout);
+    if (error)
+        return error;
+
+    bytes.resize(*actualReadSize);
+    return bytes;
+}
+
 Result<std::size_t> IUart::read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
 {
     if (bytes == nullptr)
@@ -121,4 +150,69 @@ Result<std::size_t> IUart::read(std::uint8_t* bytes, std::size_t size, osal::Tim
     return drvRead(bytes, size, timeout);
 }
 
+Result<std::size_t> IUart::read(std::span<std::uint8_t> bytes, osal::Timeout timeout)
+{
+    return read(bytes.data(), bytes.size(), timeout);
+}
+
+std::error_code IUart::startBuffering(RxCallback rxCallback, TxCallback txCallback)
+{
+    if (!rxCallback || !txCallback)
+        return Error::eInvalidArgument;
+
+    if (!isOpened())
+        return Error::eDeviceNotOpened;
+
+    return drvStartBuffering(std::move(rxCallback), std::move(txCallback));
+}
+
+std::error_code IUart::stopBuffering()
+{
+    if (!isOpened())
+        return Error::eDeviceNotOpened;
+
+    return drvStopBuffering();
+}
+
+std::error_code IUart::notifyTxPending()
+{
+    if (!isOpened())
+        return Error::eDeviceNotOpened;
+
+    return drvNotifyTxPending();
+}
+
+std::error_code IUart::prepareReconfiguration()
+{
+    if (!isOpened())
+        return Error::eOk;
+
+    // Pending data has to leave with the old settings, otherwise it would be garbled on the line.
+    auto error = drvDrain();
+    if (error == Error::eNotSupported)
+        return Error::eDeviceOpened;
+
+    return error;
+}
+
+std::error_code IUart::drvDrain()
+{
+    return Error::eNotSupported;
+}
+
+std::error_code IUart::drvStartBuffering(RxCallback /*rxCallback*/, TxCallback /*txCallback*/)
+{
+    return Error::eNotSupported;
+}
+
+std::error_code IUart::drvStopBuffering()
+{
+    return Error::eNotSupported;
+}
+
+std::error_code IUart::drvNotifyTxPending()
+{
+    return Error::eNotSupported;
+}
+
 } // namespace hal::uart
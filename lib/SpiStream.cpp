@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/spi/SpiStream.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace hal::spi {
+
+SpiStream::SpiStream(std::shared_ptr<ISpi> spi,
+                     SpiDevice device,
+                     std::size_t frameSize,
+                     std::size_t frameCount,
+                     BytesVector txFrame,
+                     std::chrono::milliseconds lockTimeout)
+    : m_spi(std::move(spi))
+    , m_device(std::move(device))
+    , m_frameSize(frameSize)
+    , m_frameStride((frameSize + cDmaAlignment - 1) / cDmaAlignment * cDmaAlignment)
+    , m_frameCount(frameCount)
+    , m_txFrame(std::move(txFrame))
+    , m_lockTimeout(lockTimeout)
+    , m_buffer(m_frameStride * (frameCount + 1))
+    , m_filledFrames(frameCount)
+    , m_freeFrames(frameCount)
+{
+    if (!m_txFrame.empty())
+        m_txFrame.resize(m_frameSize);
+
+    resetFrames();
+}
+
+SpiStream::~SpiStream()
+{
+    stop();
+}
+
+std::error_code SpiStream::start()
+{
+    if (isRunning()) {
+        SpiLogger::error("Failed to start stream: already running");
+        return Error::eWrongState;
+    }
+
+    resetFrames();
+    m_running = true;
+    if (auto error = m_thread.start([this] { worker(); })) {
+        SpiLogger::error("Failed to start stream: err={}", error.message());
+        m_running = false;
+        return error;
+    }
+
+    m_startSignal.wait();
+    if (m_startError) {
+        m_running = false;
+        m_thread.join();
+        return m_startError;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code SpiStream::stop()
+{
+    if (!isRunning())
+        return Error::eWrongState;
+
+    m_running = false;
+    m_stopSignal.signal();
+    if (auto error = m_thread.join())
+        return error;
+
+    // Software pump doesn't wait for the stop signal, so it has to be consumed here.
+    m_stopSignal.tryWait();
+    return Error::eOk;
+}
+
+Result<std::span<const std::uint8_t>> SpiStream::acquire(osal::Timeout timeout)
+{
+    if (m_acquiredFrame != m_cNoFrame) {
+        SpiLogger::error("Failed to acquire frame: previous frame is not released");
+        return Error::eWrongState;
+    }
+
+    if (m_filledSignal.timedWait(timeout))
+        return Error::eTimeout;
+
+    std::size_t index{};
+    if (!m_filledFrames.pop(index))
+        return Error::eWrongState;
+
+    m_acquiredFrame = index;
+    return std::span<const std::uint8_t>(frame(index), m_frameSize);
+}
+
+std::error_code SpiStream::release()
+{
+    if (m_acquiredFrame == m_cNoFrame) {
+        SpiLogger::error("Failed to release frame: no frame is acquired");
+        return Error::eWrongState;
+    }
+
+    m_freeFrames.push(m_acquiredFrame);
+    m_acquiredFrame = m_cNoFrame;
+    return Error::eOk;
+}
+
+SpiStreamStats SpiStream::stats() const
+{
+    SpiStreamStats stats;
+    stats.frames = m_frames.load(std::memory_order_relaxed);
+    stats.overruns = m_overruns.load(std::memory_order_relaxed);
+    stats.errors = m_errors.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SpiStream::worker()
+{
+    ScopedSpi scopedSpi(m_spi, m_device, makeTimeout(m_lockTimeout));
+    if (!scopedSpi.isAcquired()) {
+        SpiLogger::error("Stream failed to acquire the bus");
+        m_startError = Error::eTimeout;
+        m_startSignal.signal();
+        return;
+    }
+
+    auto firstFrame = nextFrame();
+    SpiStreamRing ring;
+    ring.txFrame = m_txFrame.empty() ? nullptr : m_txFrame.data();
+    ring.frames = m_buffer.data();
+    ring.frameSize = m_frameSize;
+    ring.frameStride = m_frameStride;
+    ring.frameCount = m_frameCount + 1;
+    ring.firstFrame = firstFrame;
+
+    auto error = m_spi->startStream(ring, [this](std::size_t filledFrame) { return onFrame(filledFrame); });
+    if (error && error != Error::eNotSupported) {
+        SpiLogger::error("Stream failed to start: err={}", error.message());
+        m_startError = error;
+        m_startSignal.signal();
+        return;
+    }
+
+    m_startError = Error::eOk;
+    m_startSignal.signal();
+
+    if (error == Error::eNotSupported) {
+        SpiLogger::debug("Driver doesn't support streaming, using software pump");
+        pump(scopedSpi, firstFrame);
+        return;
+    }
+
+    m_stopSignal.wait();
+    if (auto stopError = m_spi->stopStream())
+        SpiLogger::error("Failed to stop the stream: err={}", stopError.message());
+}
+
+void SpiStream::pump(ScopedSpi& scopedSpi, std::size_t firstFrame)
+{
+    const auto* txFrame = m_txFrame.empty() ? nullptr : m_txFrame.data();
+    auto index = firstFrame;
+    auto backoff = m_cMinErrorBackoff;
+
+    while (isRunning()) {
+        auto [actualSize, error] = m_spi->transfer(txFrame, frame(index), m_frameSize, osal::Timeout::infinity());
+
+        // Chip select is pulsed between the frames, so that the device can latch the next sample.
+        scopedSpi.chipSelectDisable();
+        scopedSpi.chipSelectEnable();
+
+        if (error || *actualSize != m_frameSize) {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+
+            // Persistent errors (e.g. disconnected device) would otherwise make the pump spin. Waiting for the stop
+            // signal instead of sleeping keeps stop() responsive.
+            m_stopSignal.timedWait(osal::Timeout(backoff));
+            backoff = std::min(backoff * 2, m_cMaxErrorBackoff);
+            continue;
+        }
+
+        backoff = m_cMinErrorBackoff;
+        index = onFrame(index);
+    }
+}
+
+std::size_t SpiStream::onFrame(std::size_t filledFrame)
+{
+    if (filledFrame == m_frameCount) {
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        m_filledFrames.push(filledFrame);
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+        m_filledSignal.signal();
+    }
+
+    return nextFrame();
+}
+
+void SpiStream::resetFrames()
+{
+    std::size_t index{};
+    while (m_filledFrames.pop(index))
+        m_filledSignal.tryWait();
+
+    while (m_freeFrames.pop(index)) {}
+
+    for (std::size_t i = 0; i < m_frameCount; ++i) {
+        if (i != m_acquiredFrame)
+            m_freeFrames.push(i);
+    }
+}
+
+std::size_t SpiStream::nextFrame()
+{
+    std::size_t index{};
+    if (m_freeFrames.pop(index))
+        return index;
+
+    // Scratch frame placed after the ring absorbs the data, which has no free frame to go to.
+    return m_frameCount;
+}
+
+} // namespace hal::spi
@@ -0,0 +1,188 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/TransferTracer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace hal {
+
+TransferTracer::TransferTracer(std::size_t capacity)
+    : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 1)))) // NOLINT
+    , m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1)
+{}
+
+void TransferTracer::recordTransfer(std::uint16_t address,
+                                    TransferType type,
+                                    std::size_t size,
+                                    Clock::time_point start,
+                                    Clock::time_point end,
+                                    std::error_code error)
+{
+    constexpr unsigned int cSizeShift = 32;
+    constexpr unsigned int cTypeShift = 16;
+    constexpr unsigned int cErrorShift = 32;
+
+    auto startUs = std::chrono::duration_cast<std::chrono::microseconds>(start.time_since_epoch()).count();
+    auto durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    auto index = m_head.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[index & m_mask];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.words[0].store(std::uint64_t(startUs), std::memory_order_relaxed);
+    slot.words[1].store(std::uint64_t(std::uint32_t(durationUs)) | (std::uint64_t(size) << cSizeShift),
+                        std::memory_order_relaxed);
+    slot.words[2].store(std::uint64_t(address) | (std::uint64_t(type) << cTypeShift)
+                            | (std::uint64_t(std::uint32_t(error.value())) << cErrorShift),
+                        std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    bool failed = static_cast<bool>(error);
+    accumulate(m_total, size, std::uint64_t(durationUs), failed);
+    if (auto* stats = deviceStats(address))
+        accumulate(*stats, size, std::uint64_t(durationUs), failed);
+}
+
+void TransferTracer::recordLockWait(Clock::duration wait)
+{
+    auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(wait).count();
+    m_locks.fetch_add(1, std::memory_order_relaxed);
+    m_lockWaitUs.fetch_add(std::uint64_t(waitUs), std::memory_order_relaxed);
+}
+
+std::vector<TransferRecord> TransferTracer::records() const
+{
+    constexpr unsigned int cSizeShift = 32;
+    constexpr unsigned int cTypeShift = 16;
+    constexpr unsigned int cErrorShift = 32;
+    constexpr std::uint64_t cMask16 = 0xffff;
+    constexpr std::uint64_t cMask8 = 0xff;
+
+    std::vector<TransferRecord> result;
+    auto head = m_head.load(std::memory_order_acquire);
+    auto capacity = m_mask + 1;
+    auto first = (head > capacity) ? (head - capacity) : 0;
+    result.reserve(head - first);
+
+    for (auto index = first; index < head; ++index) {
+        const auto& slot = m_slots[index & m_mask];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+            continue;
+
+        auto word0 = slot.words[0].load(std::memory_order_relaxed);
+        auto word1 = slot.words[1].load(std::memory_order_relaxed);
+        auto word2 = slot.words[2].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        TransferRecord record;
+        record.startUs = word0;
+        record.durationUs = std::uint32_t(word1);
+        record.size = std::uint32_t(word1 >> cSizeShift);
+        record.address = std::uint16_t(word2 & cMask16);
+        record.type = TransferType((word2 >> cTypeShift) & cMask8);
+        record.error = std::int32_t(std::uint32_t(word2 >> cErrorShift));
+        result.push_back(record);
+    }
+
+    return result;
+}
+
+TransferStats TransferTracer::stats(std::uint16_t address) const
+{
+    for (const auto& stats : m_devices) {
+        if (stats.key.load(std::memory_order_acquire) == std::uint32_t(address) + 1)
+            return snapshot(stats);
+    }
+
+    return {};
+}
+
+TransferStats TransferTracer::totalStats() const
+{
+    auto result = snapshot(m_total);
+    result.locks = m_locks.load(std::memory_order_relaxed);
+    result.lockWaitUs = m_lockWaitUs.load(std::memory_order_relaxed);
+    return result;
+}
+
+TransferTracer::DeviceStats* TransferTracer::deviceStats(std::uint16_t address)
+{
+    auto key = std::uint32_t(address) + 1;
+
+    for (auto& stats : m_devices) {
+        auto current = stats.key.load(std::memory_order_acquire);
+        if (current == key)
+            return &stats;
+
+        if (current == 0) {
+            std::uint32_t expected = 0;
+            if (stats.key.compare_exchange_strong(expected, key, std::memory_order_acq_rel) || expected == key)
+                return &stats;
+        }
+    }
+
+    return nullptr;
+}
+
+void TransferTracer::accumulate(DeviceStats& stats, std::size_t size, std::uint64_t durationUs, bool failed)
+{
+    auto bucket = std::min<std::size_t>(std::bit_width(durationUs), cLatencyBuckets - 1);
+
+    stats.transfers.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add(size, std::memory_order_relaxed);
+    stats.busyTimeUs.fetch_add(durationUs, std::memory_order_relaxed);
+    stats.latencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    if (failed)
+        stats.errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+TransferStats TransferTracer::snapshot(const DeviceStats& stats)
+{
+    TransferStats result;
+    result.transfers = stats.transfers.load(std::memory_order_relaxed);
+    result.errors = stats.errors.load(std::memory_order_relaxed);
+    result.bytes = stats.bytes.load(std::memory_order_relaxed);
+    result.busyTimeUs = stats.busyTimeUs.load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < cLatencyBuckets; ++i)
+        result.latencyHistogram[i] = stats.latencyHistogram[i].load(std::memory_order_relaxed);
+
+    return result;
+}
+
+} // namespace hal
@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osal/Mutex.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <vector>
+
+namespace hal {
+
+/// Represents the usage statistics of the BufferPool.
+struct BufferPoolStats {
+    std::size_t hits{};
+    std::size_t misses{};
+    std::size_t blocksInUse{};
+    std::size_t peakBlocksInUse{};
+};
+
+/// Represents the thread-safe memory resource with the fixed number of fixed-size blocks (size classes). All blocks
+/// are carved out of a single arena allocated once in the constructor, so the steady state usage does not fragment
+/// the heap. Requests, which don't fit into any free block, are forwarded to the upstream resource and counted
+/// as misses.
+/// @note Pass std::pmr::null_memory_resource() as upstream to forbid any allocation outside the arena (the arena
+///       itself is allocated from the separate arena resource). Since this library is built without exceptions,
+///       exhausting such pool terminates the program.
+class BufferPool : public std::pmr::memory_resource {
+public:
+    /// Represents the configuration of the single size class.
+    struct SizeClass {
+        std::size_t blockSize{};
+        std::size_t blockCount{};
+    };
+
+    /// Constructor.
+    /// @param sizeClasses          Size classes to be provided by this pool.
+    /// @param upstream             Memory resource used for requests not served by the pool.
+    /// @param blockAlignment       Alignment of each block (rounded up to the power of 2). Use cDmaAlignment
+    ///                             for pools dedicated to the DMA buffers.
+    /// @param arenaResource        Memory resource used once to allocate the arena (e.g. a resource placed
+    ///                             in the DMA-capable memory region).
+    explicit BufferPool(std::initializer_list<SizeClass> sizeClasses,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                        std::size_t blockAlignment = alignof(std::max_align_t),
+                        std::pmr::memory_resource* arenaResource = std::pmr::new_delete_resource());
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because BufferPool is not meant to be copy-constructed.
+    BufferPool(const BufferPool&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because BufferPool is not meant to be move-constructed.
+    BufferPool(BufferPool&&) = delete;
+
+    /// Destructor.
+    /// @note All blocks must be returned to the pool before it is destroyed.
+    ~BufferPool() override;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BufferPool is not meant to be copy-assigned.
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BufferPool is not meant to be move-assigned.
+    BufferPool& operator=(BufferPool&&) = delete;
+
+    /// Returns the current usage statistics of the pool.
+    /// @return Current usage statistics of the pool.
+    [[nodiscard]] BufferPoolStats stats() const;
+
+private:
+    /// @see std::pmr::memory_resource::do_allocate().
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override; // NOLINT(readability-identifier-naming)
+
+    /// @see std::pmr::memory_resource::do_deallocate().
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+    /// @see std::pmr::memory_resource::do_is_equal().
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /// Represents the single size class with its list of free blocks.
+    struct Slab {
+        std::size_t blockSize{};
+        std::byte* begin{};
+        std::byte* end{};
+        void* freeList{};
+    };
+
+private:
+    std::pmr::memory_resource* m_upstream;
+    std::pmr::memory_resource* m_arenaResource;
+    std::size_t m_blockAlignment;
+    std::byte* m_arena{};
+    std::size_t m_arenaSize{};
+    std::vector<Slab> m_slabs;
+    BufferPoolStats m_stats;
+    mutable osal::Mutex m_mutex;
+};
+
+} // namespace hal
@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osal/Mutex.hpp>
+#include <osal/Semaphore.hpp>
+#include <osal/Timeout.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <system_error>
+
+namespace hal {
+
+/// Represents the priority of the bus access.
+enum class BusPriority : std::uint8_t {
+    eLow,
+    eNormal,
+    eHigh,
+    eCritical
+};
+
+/// Number of the bus priority levels.
+constexpr std::size_t cBusPriorityCount = 4;
+
+/// Represents the wait time statistics of the single priority level.
+struct BusPriorityStats {
+    std::uint64_t acquisitions{};
+    std::uint64_t timeouts{};
+    std::chrono::microseconds totalWait{};
+    std::chrono::microseconds maxWait{};
+};
+
+/// Represents the statistics of the BusArbiter.
+struct BusArbiterStats {
+    std::array<BusPriorityStats, cBusPriorityCount> priorities{};
+    std::chrono::microseconds maxHold{};
+    std::uint64_t holdViolations{};
+};
+
+/// Represents the arbiter of the shared bus. When the bus is released, it is granted to the oldest waiter with
+/// the highest priority, so that latency-critical clients wait at most for the current holder to finish, regardless
+/// of the number of waiting low priority clients. Clients with the same priority are served in the FIFO order.
+/// @note Holding the bus longer than maxHoldTime is counted in the statistics. While other clients wait for the bus,
+///       they check the holder every maxHoldTime, so the violation is detected even if the bus is never released.
+///       Otherwise it is detected when the bus is released. Holder cannot be preempted, so maxHoldTime is the main
+///       factor of the worst-case acquisition time of the high priority clients and should be kept low by splitting
+///       the bulk transfers.
+/// @note Priority inheritance is not provided, because it requires changing the priority of the holding thread,
+///       which is not supported by osal. Clients should use thread priorities consistent with their bus priorities.
+class BusArbiter {
+public:
+    /// Constructor.
+    /// @param maxHoldTime      Maximal expected time of holding the bus (zero disables the check).
+    explicit BusArbiter(std::chrono::microseconds maxHoldTime = {});
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because BusArbiter is not meant to be copy-constructed.
+    BusArbiter(const BusArbiter&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because BusArbiter is not meant to be move-constructed.
+    BusArbiter(BusArbiter&&) = delete;
+
+    /// Destructor.
+    ~BusArbiter() = default;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BusArbiter is not meant to be copy-assigned.
+    BusArbiter& operator=(const BusArbiter&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BusArbiter is not meant to be move-assigned.
+    BusArbiter& operator=(BusArbiter&&) = delete;
+
+    /// Acquires the bus with the given priority.
+    /// @param priority         Priority of the bus access.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code acquire(BusPriority priority, osal::Timeout timeout);
+
+    /// Releases the bus and grants it to the next waiter (if any).
+    /// @return Error code of the operation.
+    std::error_code release();
+
+    /// Returns the statistics of the arbiter.
+    /// @return Statistics of the arbiter.
+    [[nodiscard]] BusArbiterStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Represents the single client waiting for the bus.
+    struct Waiter {
+        osal::Semaphore semaphore{0};
+        bool granted{};
+    };
+
+    /// Waits until the given waiter is granted the bus, checking the hold time of the current holder meanwhile.
+    /// @param waiter           Waiter to be granted the bus.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code waitForGrant(Waiter& waiter, osal::Timeout timeout);
+
+    /// Counts the hold time violation of the current holder, unless it has been already counted.
+    /// @param now              Current time.
+    /// @note Must be called with the mutex locked.
+    void checkHoldTime(Clock::time_point now);
+
+    /// Updates the wait time statistics of the given priority level.
+    /// @param priority         Priority level to be updated.
+    /// @param wait             Time spent waiting for the bus.
+    void updateWaitStats(BusPriority priority, Clock::duration wait);
+
+private:
+    std::chrono::microseconds m_maxHoldTime;
+    bool m_busy{};
+    bool m_holdViolated{};
+    Clock::time_point m_holdStart;
+    std::array<std::deque<Waiter*>, cBusPriorityCount> m_waiters;
+    BusArbiterStats m_stats;
+    mutable osal::Mutex m_mutex;
+};
+
+} // namespace hal
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <osal/Mutex.hpp>
+
+#ifdef HAL_THREAD_OWNERSHIP
+#include <atomic>
+#include <thread>
+#endif
+
+namespace hal {
+
+/// Represents the owner of the bus lock. Bus controllers (II2c, ISpi) use it to validate, that the calling thread
+/// holds the bus, before each transfer.
+/// @note If HAL_THREAD_OWNERSHIP is defined (platforms with std::thread, e.g. Linux), then the owner is tracked
+///       with the atomic thread id and the check costs a single relaxed load. Otherwise the check falls back
+///       to tryLock()/unlock() of the recursive bus mutex, which succeeds only for the owner or a free bus.
+class BusOwner {
+public:
+    /// Marks the calling thread as the owner of the bus.
+    /// @note Must be called right after the bus mutex has been locked.
+    void acquire()
+    {
+#ifdef HAL_THREAD_OWNERSHIP
+        m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+#else
+        m_locked = true;
+#endif
+    }
+
+    /// Clears the owner of the bus.
+    /// @note Must be called right before the bus mutex is unlocked.
+    void release()
+    {
+#ifdef HAL_THREAD_OWNERSHIP
+        m_owner.store(std::thread::id{}, std::memory_order_relaxed);
+#else
+        m_locked = false;
+#endif
+    }
+
+    /// Checks if the calling thread owns the bus.
+    /// @param mutex            Recursive mutex protecting the bus.
+    /// @return Flag indicating if the calling thread owns the bus.
+    /// @retval true            Calling thread owns the bus.
+    /// @retval false           Bus is free or owned by another thread.
+    [[nodiscard]] bool isOwner([[maybe_unused]] osal::Mutex& mutex) const
+    {
+#ifdef HAL_THREAD_OWNERSHIP
+        return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+#else
+        if (mutex.tryLock())
+            return false;
+
+        bool result = m_locked;
+        mutex.unlock();
+        return result;
+#endif
+    }
+
+    /// Checks if the bus is owned by any thread.
+    /// @return Flag indicating if the bus is owned by any thread.
+    /// @retval true            Bus is owned.
+    /// @retval false           Bus is free.
+    [[nodiscard]] bool isOwned() const
+    {
+#ifdef HAL_THREAD_OWNERSHIP
+        return m_owner.load(std::memory_order_relaxed) != std::thread::id{};
+#else
+        return m_locked;
+#endif
+    }
+
+    /// Takes over the ownership state from the given object and clears it there.
+    /// @param other            Object to take the state from.
+    void takeOver(BusOwner& other)
+    {
+#ifdef HAL_THREAD_OWNERSHIP
+        m_owner.store(other.m_owner.exchange(std::thread::id{}));
+#else
+        m_locked = other.m_locked;
+        other.m_locked = false;
+#endif
+    }
+
+private:
+#ifdef HAL_THREAD_OWNERSHIP
+    std::atomic<std::thread::id> m_owner{};
+#else
+    bool m_locked{};
+#endif
+};
+
+} // namespace hal
@@ -0,0 +1,123 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+
+namespace hal {
+
+/// Alignment of the DMA buffers. It covers the cache line size of all supported cores, so that cache maintenance
+/// operations performed by the driver never touch the memory outside of the buffer.
+constexpr std::size_t cDmaAlignment = 64;
+
+/// Represents the memory block, which can be used by the drivers as the DMA source or destination without any
+/// bounce buffer. Buffer is aligned to cDmaAlignment and its capacity is padded to the multiple of cDmaAlignment,
+/// so it exclusively owns all cache lines it occupies.
+/// @note Memory is allocated from the given memory resource. Use the BufferPool constructed with cDmaAlignment
+///       (and placed in the DMA-capable memory region, if required by the platform) to avoid heap allocations.
+class DmaBuffer {
+public:
+    /// Default constructor. Creates an empty buffer.
+    DmaBuffer() = default;
+
+    /// Constructor.
+    /// @param size                 Size of the buffer in bytes.
+    /// @param resource             Memory resource used to allocate the buffer.
+    explicit DmaBuffer(std::size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because DmaBuffer is not meant to be copy-constructed.
+    DmaBuffer(const DmaBuffer&) = delete;
+
+    /// Move constructor.
+    /// @param other                Object to be moved from.
+    DmaBuffer(DmaBuffer&& other) noexcept;
+
+    /// Destructor.
+    ~DmaBuffer();
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because DmaBuffer is not meant to be copy-assigned.
+    DmaBuffer& operator=(const DmaBuffer&) = delete;
+
+    /// Move assignment operator.
+    /// @param other                Object to be moved from.
+    /// @return Reference to self.
+    DmaBuffer& operator=(DmaBuffer&& other) noexcept;
+
+    /// Returns pointer to the beginning of the buffer.
+    /// @return Pointer to the beginning of the buffer.
+    [[nodiscard]] std::uint8_t* data() { return m_data; }
+
+    /// Returns pointer to the beginning of the buffer.
+    /// @return Pointer to the beginning of the buffer.
+    [[nodiscard]] const std::uint8_t* data() const { return m_data; }
+
+    /// Returns size of the buffer in bytes.
+    /// @return Size of the buffer in bytes.
+    [[nodiscard]] std::size_t size() const { return m_size; }
+
+    /// Returns number of bytes owned by the buffer (size padded to the multiple of cDmaAlignment).
+    /// @return Number of bytes owned by the buffer.
+    [[nodiscard]] std::size_t capacity() const { return m_capacity; }
+
+    /// Checks if the buffer is empty.
+    /// @return Flag indicating if the buffer is empty.
+    /// @retval true                Buffer is empty.
+    /// @retval false               Buffer is not empty.
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /// Returns span covering the whole buffer.
+    /// @return Span covering the whole buffer.
+    [[nodiscard]] std::span<std::uint8_t> span() { return {m_data, m_size}; }
+
+    /// Returns span covering the whole buffer.
+    /// @return Span covering the whole buffer.
+    [[nodiscard]] std::span<const std::uint8_t> span() const { return {m_data, m_size}; }
+
+private:
+    /// Releases the memory owned by the buffer.
+    void release();
+
+private:
+    std::pmr::memory_resource* m_resource{};
+    std::uint8_t* m_data{};
+    std::size_t m_size{};
+    std::size_t m_capacity{};
+};
+
+} // namespace hal
@@ -52,7 +52,10 @@ enum class Error {
     ePathExists,
     ePathDoesNotExist,
     eFilesystemError,
-    eHardwareError
+    eHardwareError,
+    eNack,
+    eArbitrationLost,
+    eFrameError
 };
 
 /// Creates error code value for Error enum.
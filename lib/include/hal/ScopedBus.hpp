@@ -0,0 +1,176 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/BusArbiter.hpp"
+#include "hal/Error.hpp"
+
+#include <osal/Timeout.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <utility>
+
+namespace hal {
+
+/// Represents the RAII object to acquire the bus (e.g. II2c or ISpi) in a valid manner. In constructor it
+/// automatically locks the bus. In destructor it automatically unlocks the bus. Guard stores only the raw pointer
+/// to the bus, so it is cheap to create and can be moved (e.g. returned from functions or stored in transaction
+/// objects).
+/// @tparam Bus                 Type of the bus. It must provide lock(osal::Timeout, BusPriority) and unlock().
+/// @note Bus must outlive the guard. Bus is locked by the calling thread, so the guard must be released by the same
+///       thread, which has acquired it.
+template <typename Bus>
+class ScopedBus {
+public:
+    /// Constructor.
+    /// @param bus              Reference to the bus.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @param priority         Priority of the bus access.
+    /// @note This constructor automatically locks the bus.
+    explicit ScopedBus(Bus& bus,
+                       osal::Timeout timeout = osal::Timeout::infinity(),
+                       BusPriority priority = BusPriority::eNormal)
+        : m_bus(&bus)
+    {
+        static_cast<void>(acquire(timeout, priority));
+    }
+
+    /// Constructor.
+    /// @param bus              Shared pointer to the bus.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @param priority         Priority of the bus access.
+    /// @note This constructor automatically locks the bus. Shared pointer is not stored.
+    explicit ScopedBus(const std::shared_ptr<Bus>& bus,
+                       osal::Timeout timeout = osal::Timeout::infinity(),
+                       BusPriority priority = BusPriority::eNormal)
+        : ScopedBus(*bus, timeout, priority)
+    {}
+
+    /// Constructor. Doesn't lock the bus, so that it can be acquired later (e.g. with tryAcquire()).
+    /// @param bus              Reference to the bus.
+    ScopedBus(Bus& bus, std::defer_lock_t /*unused*/)
+        : m_bus(&bus)
+    {}
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because ScopedBus is not meant to be copy-constructed.
+    ScopedBus(const ScopedBus&) = delete;
+
+    /// Move constructor.
+    /// @param other            Object to be moved from.
+    ScopedBus(ScopedBus&& other) noexcept
+        : m_bus(std::exchange(other.m_bus, nullptr))
+        , m_locked(std::exchange(other.m_locked, false))
+    {}
+
+    /// Destructor.
+    /// @note This destructor automatically unlocks the bus.
+    ~ScopedBus() { release(); }
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because ScopedBus is not meant to be copy-assigned.
+    ScopedBus& operator=(const ScopedBus&) = delete;
+
+    /// Move assignment operator.
+    /// @param other            Object to be moved from.
+    /// @return Reference to self.
+    /// @note Bus held by this object (if any) is released first.
+    ScopedBus& operator=(ScopedBus&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_bus = std::exchange(other.m_bus, nullptr);
+            m_locked = std::exchange(other.m_locked, false);
+        }
+
+        return *this;
+    }
+
+    /// Acquires the bus.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @param priority         Priority of the bus access.
+    /// @return Error code of the operation.
+    [[nodiscard]] std::error_code acquire(osal::Timeout timeout, BusPriority priority = BusPriority::eNormal)
+    {
+        if (m_bus == nullptr || isAcquired())
+            return Error::eWrongState;
+
+        if (auto error = m_bus->lock(timeout, priority))
+            return error;
+
+        m_locked = true;
+        return Error::eOk;
+    }
+
+    /// Acquires the bus only if it is available immediately.
+    /// @param priority         Priority of the bus access.
+    /// @return Error code of the operation.
+    [[nodiscard]] std::error_code tryAcquire(BusPriority priority = BusPriority::eNormal)
+    {
+        return acquire(osal::Timeout(std::chrono::milliseconds(0)), priority);
+    }
+
+    /// Releases the bus.
+    /// @return Error code of the operation.
+    std::error_code release()
+    {
+        if (!isAcquired())
+            return Error::eWrongState;
+
+        if (auto error = m_bus->unlock())
+            return error;
+
+        m_locked = false;
+        return Error::eOk;
+    }
+
+    /// Returns the flag indicating if the bus has been acquired.
+    /// @return Flag indicating if the bus has been acquired.
+    /// @retval true            Bus has been acquired.
+    /// @retval false           Bus has not been acquired.
+    [[nodiscard]] bool isAcquired() const { return m_locked; }
+
+    /// Returns the guarded bus.
+    /// @return Pointer to the guarded bus (nullptr if the guard has been moved from).
+    [[nodiscard]] Bus* bus() const { return m_bus; }
+
+private:
+    Bus* m_bus{};
+    bool m_locked{};
+};
+
+} // namespace hal
@@ -0,0 +1,173 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hal {
+
+/// Represents the bounded lock-free queue with the single producer and the single consumer. Both push() and pop()
+/// are wait-free, so they can be used from the interrupt context or the real-time thread, as long as there is
+/// exactly one thread (or ISR) on each side.
+/// @tparam T                   Type of the queued elements.
+/// @note Capacity is rounded up to the power of 2.
+template <typename T>
+class SpscQueue {
+public:
+    /// Constructor.
+    /// @param capacity             Maximal number of elements in the queue (rounded up to the power of 2).
+    explicit SpscQueue(std::size_t capacity)
+        : m_buffer(std::bit_ceil(std::max<std::size_t>(capacity, 1)))
+        , m_mask(m_buffer.size() - 1)
+    {}
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because SpscQueue is not meant to be copy-constructed.
+    SpscQueue(const SpscQueue&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because SpscQueue is not meant to be move-constructed.
+    SpscQueue(SpscQueue&&) = delete;
+
+    /// Destructor.
+    ~SpscQueue() = default;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because SpscQueue is not meant to be copy-assigned.
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because SpscQueue is not meant to be move-assigned.
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    /// Pushes given element to the queue. Must be called only by the producer.
+    /// @param value                Element to be pushed.
+    /// @return Flag indicating if the element has been pushed.
+    /// @retval true                Element has been pushed.
+    /// @retval false               Queue is full.
+    bool push(T value)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_buffer.size())
+            return false;
+
+        m_buffer[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pops the oldest element from the queue. Must be called only by the consumer.
+    /// @param value                Object, where the popped element will be placed.
+    /// @return Flag indicating if the element has been popped.
+    /// @retval true                Element has been popped.
+    /// @retval false               Queue is empty.
+    bool pop(T& value)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        value = std::move(m_buffer[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pushes given block of elements to the queue. Must be called only by the producer.
+    /// @param values               Elements to be pushed.
+    /// @param count                Number of elements to be pushed.
+    /// @return Number of elements, which have been pushed (less than count if the queue is full).
+    /// @note Whole block is published at once, so the consumer pays for the synchronization once per block.
+    std::size_t push(const T* values, std::size_t count)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto space = m_buffer.size() - (tail - m_head.load(std::memory_order_acquire));
+        count = std::min(count, space);
+
+        for (std::size_t i = 0; i < count; ++i)
+            m_buffer[(tail + i) & m_mask] = values[i];
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Pops the oldest block of elements from the queue. Must be called only by the consumer.
+    /// @param values               Memory block, where the popped elements will be placed.
+    /// @param count                Maximal number of elements to be popped.
+    /// @return Number of elements, which have been popped (less than count if the queue has not enough elements).
+    std::size_t pop(T* values, std::size_t count)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        count = std::min(count, m_tail.load(std::memory_order_acquire) - head);
+
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = std::move(m_buffer[(head + i) & m_mask]);
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Returns the number of elements in the queue.
+    /// @return Number of elements in the queue.
+    /// @note Result is exact only when called by the producer or the consumer, otherwise it is a snapshot.
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /// Checks if the queue is empty.
+    /// @return Flag indicating if the queue is empty.
+    /// @retval true                Queue is empty.
+    /// @retval false               Queue is not empty.
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /// Returns the maximal number of elements in the queue.
+    /// @return Maximal number of elements in the queue.
+    [[nodiscard]] std::size_t capacity() const { return m_buffer.size(); }
+
+private:
+    static constexpr std::size_t m_cCacheLineSize = 64;
+
+    std::vector<T> m_buffer;
+    std::size_t m_mask;
+    alignas(m_cCacheLineSize) std::atomic<std::size_t> m_head{};
+    alignas(m_cCacheLineSize) std::atomic<std::size_t> m_tail{};
+};
+
+} // namespace hal
@@ -0,0 +1,212 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <utils/types/Result.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace hal {
+
+/// Represents the type of the traced transfer.
+enum class TransferType : std::uint8_t {
+    eWrite,
+    eRead,
+    eTransfer
+};
+
+/// Represents a single traced bus transfer.
+struct TransferRecord {
+    std::uint64_t startUs{};
+    std::uint32_t durationUs{};
+    std::uint32_t size{};
+    std::uint16_t address{};
+    TransferType type{};
+    std::int32_t error{};
+};
+
+/// Number of buckets in the latency histogram. Bucket i counts transfers, which lasted [2^(i-1), 2^i) us
+/// (bucket 0 counts transfers shorter than 1 us, the last bucket counts also all longer transfers).
+constexpr std::size_t cLatencyBuckets = 24;
+
+/// Represents the aggregated statistics of the traced transfers.
+/// @note Bus is locked before any device is addressed, so the lock statistics (locks and lockWaitUs) are kept only
+///       for the whole bus and are always 0 in the per-device statistics.
+struct TransferStats {
+    std::uint64_t transfers{};
+    std::uint64_t errors{};
+    std::uint64_t bytes{};
+    std::uint64_t busyTimeUs{};
+    std::uint64_t locks{};
+    std::uint64_t lockWaitUs{};
+    std::array<std::uint64_t, cLatencyBuckets> latencyHistogram{};
+};
+
+/// Represents the low-overhead tracer of the bus transfers. Each transfer is stored in the lock-free ring buffer
+/// (overwriting the oldest records) and accumulated in the per-device statistics. Recording a transfer costs two
+/// clock reads and a handful of relaxed atomic operations, so it can stay enabled in the production builds.
+/// @note Statistics are kept for up to cMaxDevices different addresses. Transfers to other addresses are accumulated
+///       only in the total statistics.
+class TransferTracer {
+public:
+    /// Represents the clock used to timestamp the transfers.
+    using Clock = std::chrono::steady_clock;
+
+    /// Maximal number of devices (addresses) with separate statistics.
+    static constexpr std::size_t cMaxDevices = 16;
+
+    /// Constructor.
+    /// @param capacity         Number of records in the ring buffer (rounded up to the power of 2).
+    explicit TransferTracer(std::size_t capacity);
+
+    /// Records the completed transfer.
+    /// @param address          Address of the device (0 for buses without addressing).
+    /// @param type             Type of the transfer.
+    /// @param size             Number of bytes in the transfer.
+    /// @param start            Time point at which the transfer has started.
+    /// @param end              Time point at which the transfer has ended.
+    /// @param error            Result of the transfer.
+    void recordTransfer(std::uint16_t address,
+                        TransferType type,
+                        std::size_t size,
+                        Clock::time_point start,
+                        Clock::time_point end,
+                        std::error_code error);
+
+    /// Records the time spent waiting for the bus lock (accumulated only in the total statistics).
+    /// @param wait             Time spent waiting for the bus lock.
+    void recordLockWait(Clock::duration wait);
+
+    /// Returns the most recent records from the ring buffer (oldest first).
+    /// @return Most recent records from the ring buffer.
+    [[nodiscard]] std::vector<TransferRecord> records() const;
+
+    /// Returns statistics of the given device.
+    /// @param address          Address of the device.
+    /// @return Statistics of the given device.
+    [[nodiscard]] TransferStats stats(std::uint16_t address) const;
+
+    /// Returns statistics of all transfers.
+    /// @return Statistics of all transfers.
+    [[nodiscard]] TransferStats totalStats() const;
+
+    /// Executes the given operation and records it in the given tracer (if any).
+    /// @tparam Operation       Type of the callable performing the transfer.
+    /// @param tracer           Tracer to be used (may be nullptr).
+    /// @param address          Address of the device (0 for buses without addressing).
+    /// @param type             Type of the transfer.
+    /// @param size             Number of bytes in the transfer.
+    /// @param operation        Callable performing the transfer and returning std::error_code or Result.
+    /// @return Result of the operation.
+    template <typename Operation>
+    static auto
+    trace(TransferTracer* tracer, std::uint16_t address, TransferType type, std::size_t size, Operation operation)
+    {
+        if (tracer == nullptr)
+            return operation();
+
+        auto start = Clock::now();
+        auto result = operation();
+        tracer->recordTransfer(address, type, size, start, Clock::now(), errorOf(result));
+        return result;
+    }
+
+private:
+    /// Represents the accumulated statistics of the single device.
+    struct DeviceStats {
+        std::atomic<std::uint32_t> key{};
+        std::atomic<std::uint64_t> transfers{};
+        std::atomic<std::uint64_t> errors{};
+        std::atomic<std::uint64_t> bytes{};
+        std::atomic<std::uint64_t> busyTimeUs{};
+        std::array<std::atomic<std::uint64_t>, cLatencyBuckets> latencyHistogram{};
+    };
+
+    /// Represents the single slot of the ring buffer protected by the sequence lock. Record is packed into atomic
+    /// words, so that concurrent readers never observe a data race.
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{};
+        std::array<std::atomic<std::uint64_t>, 3> words{};
+    };
+
+    /// Returns statistics slot of the given device, allocating it if needed.
+    /// @param address          Address of the device.
+    /// @return Statistics slot of the given device or nullptr if all slots are taken.
+    DeviceStats* deviceStats(std::uint16_t address);
+
+    /// Accumulates the given transfer in the given statistics.
+    /// @param stats            Statistics to be updated.
+    /// @param size             Number of bytes in the transfer.
+    /// @param durationUs       Duration of the transfer in us.
+    /// @param failed           Flag indicating if the transfer has failed.
+    static void accumulate(DeviceStats& stats, std::size_t size, std::uint64_t durationUs, bool failed);
+
+    /// Converts the given statistics into the snapshot.
+    /// @param stats            Statistics to be converted.
+    /// @return Snapshot of the given statistics.
+    static TransferStats snapshot(const DeviceStats& stats);
+
+    /// Extracts the error code from the operation result.
+    /// @param error            Result of the operation.
+    /// @return Error code of the operation.
+    static std::error_code errorOf(std::error_code error) { return error; }
+
+    /// Extracts the error code from the operation result.
+    /// @tparam T               Type of the value held by the result.
+    /// @param result           Result of the operation.
+    /// @return Error code of the operation.
+    template <typename T>
+    static std::error_code errorOf(const Result<T>& result)
+    {
+        const auto& [value, error] = result;
+        return error;
+    }
+
+private:
+    std::unique_ptr<Slot[]> m_slots; // NOLINT(modernize-avoid-c-arrays)
+    std::size_t m_mask;
+    std::atomic<std::uint64_t> m_head{};
+    std::array<DeviceStats, cMaxDevices> m_devices{};
+    DeviceStats m_total{};
+    std::atomic<std::uint64_t> m_locks{};
+    std::atomic<std::uint64_t> m_lockWaitUs{};
+};
+
+} // namespace hal
@@ -0,0 +1,186 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/async/Task.hpp"
+
+#include <osal/Mutex.hpp>
+#include <osal/Semaphore.hpp>
+#include <osal/Thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace hal::async {
+
+namespace detail {
+
+/// Represents the blocking operation, which is executed by the worker thread of the executor before resuming
+/// the coroutine awaiting it.
+class IOperation {
+public:
+    /// Default constructor.
+    IOperation() = default;
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because IOperation is not meant to be copy-constructed.
+    IOperation(const IOperation&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because IOperation is not meant to be move-constructed.
+    IOperation(IOperation&&) = delete;
+
+    /// Virtual destructor.
+    virtual ~IOperation() = default;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because IOperation is not meant to be copy-assigned.
+    IOperation& operator=(const IOperation&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because IOperation is not meant to be move-assigned.
+    IOperation& operator=(IOperation&&) = delete;
+
+    /// Executes the operation and stores its result.
+    virtual void execute() = 0;
+};
+
+} // namespace detail
+
+/// Represents the single-threaded executor of the Task coroutines. Each awaited bus operation is handed over to
+/// the worker thread of the executor and executed in the FIFO order, while other coroutines keep running on
+/// the thread calling run(). This way many device state machines can be multiplexed on one thread and a single
+/// operation waiting for its timeout doesn't stall the rest of them.
+/// @note Blocking operations are executed by the worker thread, which locks II2c and ISpi buses only for
+///       the duration of each operation. Buses used by the coroutines must not be locked by the thread calling
+///       run(), because the worker would never acquire them.
+class Executor {
+public:
+    /// Represents the clock used by the executor timers.
+    using Clock = std::chrono::steady_clock;
+
+    /// Default constructor.
+    Executor() = default;
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because Executor is not meant to be copy-constructed.
+    Executor(const Executor&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because Executor is not meant to be move-constructed.
+    Executor(Executor&&) = delete;
+
+    /// Destructor. Stops the worker thread and destroys all unfinished tasks.
+    /// @note Operations, which have not been executed yet, are discarded and tasks awaiting them (or any other
+    ///       event) are destroyed without being resumed, so their local objects are destructed in the usual way.
+    ~Executor();
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because Executor is not meant to be copy-assigned.
+    Executor& operator=(const Executor&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because Executor is not meant to be move-assigned.
+    Executor& operator=(Executor&&) = delete;
+
+    /// Spawns the given task in the executor. Task is started in the next run() or runOnce() call.
+    /// @param task             Task to be spawned.
+    void spawn(Task task);
+
+    /// Schedules the given coroutine to be resumed after the given operation has been executed.
+    /// @param handle           Coroutine to be resumed.
+    /// @param operation        Operation to be executed by the worker thread before resuming the coroutine
+    ///                         (may be nullptr).
+    /// @note The worker thread is started with the first posted operation.
+    void post(std::coroutine_handle<> handle, detail::IOperation* operation = nullptr);
+
+    /// Schedules the given coroutine to be resumed at the given time point.
+    /// @param handle           Coroutine to be resumed.
+    /// @param timePoint        Time point at which the coroutine should be resumed.
+    void postAt(std::coroutine_handle<> handle, Clock::time_point timePoint);
+
+    /// Resumes the oldest coroutine, which is ready to be resumed (i.e. its operation has been executed by
+    /// the worker thread or its timer has expired).
+    /// @return Flag indicating if any coroutine has been resumed.
+    /// @retval true            Coroutine has been resumed.
+    /// @retval false           There were no coroutines ready to be resumed.
+    bool runOnce();
+
+    /// Runs the executor until all spawned tasks are finished.
+    void run();
+
+    /// Returns the number of tasks, which are not yet finished.
+    /// @return Number of tasks, which are not yet finished.
+    [[nodiscard]] std::size_t activeTasks() const { return m_activeTasks; }
+
+private:
+    /// Represents the coroutine waiting for the operation to be executed by the worker thread.
+    struct OperationEntry {
+        std::coroutine_handle<> handle;
+        detail::IOperation* operation{};
+    };
+
+    /// Represents the coroutine waiting for the given time point.
+    struct TimerEntry {
+        std::coroutine_handle<> handle;
+        Clock::time_point timePoint;
+    };
+
+private:
+    /// Executes the posted operations until the executor is destroyed.
+    void worker();
+
+private:
+    std::deque<std::coroutine_handle<>> m_ready;
+    std::vector<TimerEntry> m_timers;
+    std::size_t m_activeTasks{};
+    std::size_t m_pendingOperations{};
+    osal::Mutex m_mutex;
+    std::deque<OperationEntry> m_operations;
+    std::deque<std::coroutine_handle<>> m_completed;
+    osal::Semaphore m_operationsSignal{0};
+    osal::Semaphore m_completedSignal{0};
+    std::atomic_bool m_stopping{};
+    bool m_workerStarted{};
+    osal::Thread<> m_thread;
+};
+
+} // namespace hal::async
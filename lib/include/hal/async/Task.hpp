@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <coroutine>
+#include <cstdlib>
+#include <utility>
+
+namespace hal::async {
+
+class Executor;
+
+/// Represents the coroutine, which can be spawned in the Executor. Tasks are lazily started, which means that
+/// the coroutine body is executed only after the task has been spawned.
+/// @note Task is the only coroutine type accepted by the awaitables from this module.
+class Task {
+public:
+    /// Represents the promise type of the Task coroutine.
+    struct promise_type { // NOLINT(readability-identifier-naming)
+        Executor* executor{};
+
+        /// Creates the Task object associated with this promise.
+        /// @return Task object associated with this promise.
+        Task get_return_object() // NOLINT(readability-identifier-naming)
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        /// Suspends the coroutine right after its creation.
+        /// @return Awaitable object suspending the coroutine.
+        std::suspend_always initial_suspend() noexcept { return {}; } // NOLINT(readability-identifier-naming)
+
+        /// Suspends the coroutine after its completion, so that the executor can destroy it.
+        /// @return Awaitable object suspending the coroutine.
+        std::suspend_always final_suspend() noexcept { return {}; } // NOLINT(readability-identifier-naming)
+
+        /// Handles the co_return statement.
+        void return_void() {} // NOLINT(readability-identifier-naming)
+
+        /// Handles the unhandled exception. Exceptions are disabled in this library, so this is never expected.
+        void unhandled_exception() { std::abort(); } // NOLINT(readability-identifier-naming)
+    };
+
+    /// Represents the coroutine handle type of the Task.
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because Task is not meant to be copy-constructed.
+    Task(const Task&) = delete;
+
+    /// Move constructor.
+    /// @param other            Task object to be moved into current instance.
+    Task(Task&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {}))
+    {}
+
+    /// Destructor.
+    /// @note This destructor destroys the coroutine only if it has not been spawned in the executor.
+    ~Task()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because Task is not meant to be copy-assigned.
+    Task& operator=(const Task&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because Task is not meant to be move-assigned.
+    Task& operator=(Task&&) = delete;
+
+    /// Releases the ownership of the coroutine handle.
+    /// @return Coroutine handle owned by this task.
+    Handle release() { return std::exchange(m_handle, {}); }
+
+private:
+    /// Constructor.
+    /// @param handle           Coroutine handle to be owned by this task.
+    explicit Task(Handle handle)
+        : m_handle(handle)
+    {}
+
+private:
+    Handle m_handle;
+};
+
+} // namespace hal::async
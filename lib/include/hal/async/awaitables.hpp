@@ -0,0 +1,370 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/ScopedBus.hpp"
+#include "hal/async/Executor.hpp"
+#include "hal/async/Task.hpp"
+#include "hal/i2c/II2c.hpp"
+#include "hal/i2c/ScopedI2c.hpp"
+#include "hal/spi/ISpi.hpp"
+#include "hal/spi/ScopedSpi.hpp"
+#include "hal/spi/SpiDevice.hpp"
+#include "hal/uart/IUart.hpp"
+
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+namespace hal::async {
+
+/// Represents the infinite timeout of the awaitable operation.
+inline constexpr auto cInfinity = std::chrono::milliseconds::max();
+
+/// Represents the awaitable wrapping the blocking bus operation. Operation is handed over to the worker thread of
+/// the executor, so that other coroutines are resumed while it is being executed.
+/// @tparam ResultType      Type of the operation result.
+/// @tparam Function        Type of the callable performing the operation. It is called with the timeout of
+///                         the operation.
+template <typename ResultType, typename Function>
+class Operation : public detail::IOperation {
+public:
+    /// Constructor.
+    /// @param function         Callable performing the operation.
+    /// @param timeout          Maximal time to wait for the operation, measured from the moment it is awaited.
+    Operation(Function function, std::chrono::milliseconds timeout)
+        : m_function(std::move(function))
+        , m_duration(timeout)
+    {}
+
+    /// Checks if the operation result is already available.
+    /// @return Flag indicating if the operation result is already available.
+    [[nodiscard]] bool await_ready() const noexcept { return false; } // NOLINT(readability-identifier-naming)
+
+    /// Starts the timeout and schedules this operation in the executor of the awaiting task.
+    /// @param handle           Awaiting task.
+    void await_suspend(Task::Handle handle) // NOLINT(readability-identifier-naming)
+    {
+        assert(handle.promise().executor);
+        m_timeout.emplace((m_duration == cInfinity) ? osal::Timeout::infinity() : osal::Timeout(m_duration));
+        handle.promise().executor->post(handle, this);
+    }
+
+    /// Returns the result of the operation.
+    /// @return Result of the operation.
+    ResultType await_resume() { return std::move(*m_result); } // NOLINT(readability-identifier-naming)
+
+    /// @see IOperation::execute().
+    void execute() override { m_result.emplace(m_function(*m_timeout)); }
+
+private:
+    Function m_function;
+    std::chrono::milliseconds m_duration;
+    std::optional<osal::Timeout> m_timeout;
+    std::optional<ResultType> m_result;
+};
+
+/// Creates the awaitable wrapping the given blocking operation.
+/// @tparam Function        Type of the callable performing the operation.
+/// @param function         Callable performing the operation. It is called by the worker thread of the executor
+///                         with the timeout of the operation.
+/// @param timeout          Maximal time to wait for the operation, measured from the moment it is awaited.
+/// @return Awaitable wrapping the given operation.
+template <typename Function>
+auto makeOperation(Function function, std::chrono::milliseconds timeout = cInfinity)
+{
+    using ResultType = decltype(function(std::declval<osal::Timeout>()));
+    return Operation<ResultType, Function>(std::move(function), timeout);
+}
+
+/// Represents the awaitable suspending the task until the given time point.
+class SleepUntil {
+public:
+    /// Constructor.
+    /// @param timePoint        Time point until which the task should be suspended.
+    explicit SleepUntil(Executor::Clock::time_point timePoint)
+        : m_timePoint(timePoint)
+    {}
+
+    /// Checks if the time point has already passed.
+    /// @return Flag indicating if the time point has already passed.
+    [[nodiscard]] bool await_ready() const noexcept // NOLINT(readability-identifier-naming)
+    {
+        return Executor::Clock::now() >= m_timePoint;
+    }
+
+    /// Schedules the awaiting task in the timer queue of its executor.
+    /// @param handle           Awaiting task.
+    void await_suspend(Task::Handle handle) const // NOLINT(readability-identifier-naming)
+    {
+        assert(handle.promise().executor);
+        handle.promise().executor->postAt(handle, m_timePoint);
+    }
+
+    /// Resumes the task.
+    void await_resume() const noexcept {} // NOLINT(readability-identifier-naming)
+
+private:
+    Executor::Clock::time_point m_timePoint;
+};
+
+/// Suspends the task for the given duration without blocking other tasks.
+/// @param duration         Time for which the task should be suspended.
+/// @return Awaitable suspending the task.
+template <typename Rep, typename Period>
+SleepUntil sleep(std::chrono::duration<Rep, Period> duration)
+{
+    return SleepUntil(Executor::Clock::now() + duration);
+}
+
+/// Represents the awaitable suspending the task, so that all other ready tasks are resumed before it.
+class Yield {
+public:
+    /// Checks if the task can be resumed without suspending.
+    /// @return Flag indicating if the task can be resumed without suspending.
+    [[nodiscard]] bool await_ready() const noexcept { return false; } // NOLINT(readability-identifier-naming)
+
+    /// Schedules the awaiting task at the end of the ready queue of its executor.
+    /// @param handle           Awaiting task.
+    void await_suspend(Task::Handle handle) const // NOLINT(readability-identifier-naming)
+    {
+        assert(handle.promise().executor);
+        handle.promise().executor->post(handle);
+    }
+
+    /// Resumes the task.
+    void await_resume() const noexcept {} // NOLINT(readability-identifier-naming)
+};
+
+/// Suspends the task, so that all other ready tasks are resumed before it.
+/// @return Awaitable suspending the task.
+inline Yield yield()
+{
+    return {};
+}
+
+/// Awaitable version of II2c::write(). Bus is locked by the worker thread for the duration of the operation.
+/// @see II2c::write().
+inline auto write(i2c::II2c& i2c,
+                  std::uint16_t address,
+                  const std::uint8_t* bytes,
+                  std::size_t size,
+                  bool stop,
+                  std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &i2c](osal::Timeout timeout) -> std::error_code {
+        i2c::ScopedI2c i2cGuard(i2c, std::defer_lock);
+        if (auto error = i2cGuard.acquire(timeout))
+            return error;
+
+        return i2c.write(address, bytes, size, stop, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of II2c::read(). Bus is locked by the worker thread for the duration of the operation.
+/// @see II2c::read().
+inline auto read(i2c::II2c& i2c,
+                 std::uint16_t address,
+                 std::uint8_t* bytes,
+                 std::size_t size,
+                 std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &i2c](osal::Timeout timeout) -> Result<std::size_t> {
+        i2c::ScopedI2c i2cGuard(i2c, std::defer_lock);
+        if (auto error = i2cGuard.acquire(timeout))
+            return error;
+
+        return i2c.read(address, bytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of II2c::writeRead(). Bus is locked by the worker thread for the duration of the operation.
+/// @see II2c::writeRead().
+inline auto writeRead(i2c::II2c& i2c,
+                      std::uint16_t address,
+                      const std::uint8_t* txBytes,
+                      std::size_t txSize,
+                      std::uint8_t* rxBytes,
+                      std::size_t rxSize,
+                      std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &i2c](osal::Timeout timeout) -> Result<std::size_t> {
+        i2c::ScopedI2c i2cGuard(i2c, std::defer_lock);
+        if (auto error = i2cGuard.acquire(timeout))
+            return error;
+
+        return i2c.writeRead(address, txBytes, txSize, rxBytes, rxSize, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::write(). Bus is locked by the worker thread for the duration of the operation.
+/// @see ISpi::write().
+/// @note Chip select has to be driven by the SPI driver. Use the overload taking SpiDevice otherwise.
+inline auto write(spi::ISpi& spi, const std::uint8_t* bytes, std::size_t size, std::chrono::milliseconds timeout)
+{
+    auto function = [=, &spi](osal::Timeout timeout) -> std::error_code {
+        ScopedBus<spi::ISpi> spiGuard(spi, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.write(bytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::write(). Device is acquired by the worker thread for the duration of the operation.
+/// @see ISpi::write().
+inline auto write(spi::ISpi& spi,
+                  const spi::SpiDevice& device,
+                  const std::uint8_t* bytes,
+                  std::size_t size,
+                  std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &spi, &device](osal::Timeout timeout) -> std::error_code {
+        spi::ScopedSpi spiGuard(spi, device, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.write(bytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::read(). Bus is locked by the worker thread for the duration of the operation.
+/// @see ISpi::read().
+/// @note Chip select has to be driven by the SPI driver. Use the overload taking SpiDevice otherwise.
+inline auto read(spi::ISpi& spi, std::uint8_t* bytes, std::size_t size, std::chrono::milliseconds timeout)
+{
+    auto function = [=, &spi](osal::Timeout timeout) -> Result<std::size_t> {
+        ScopedBus<spi::ISpi> spiGuard(spi, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.read(bytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::read(). Device is acquired by the worker thread for the duration of the operation.
+/// @see ISpi::read().
+inline auto read(spi::ISpi& spi,
+                 const spi::SpiDevice& device,
+                 std::uint8_t* bytes,
+                 std::size_t size,
+                 std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &spi, &device](osal::Timeout timeout) -> Result<std::size_t> {
+        spi::ScopedSpi spiGuard(spi, device, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.read(bytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::transfer(). Bus is locked by the worker thread for the duration of the operation.
+/// @see ISpi::transfer().
+/// @note Chip select has to be driven by the SPI driver. Use the overload taking SpiDevice otherwise.
+inline auto transfer(spi::ISpi& spi,
+                     const std::uint8_t* txBytes,
+                     std::uint8_t* rxBytes,
+                     std::size_t size,
+                     std::chrono::milliseconds timeout)
+{
+    auto function = [=, &spi](osal::Timeout timeout) -> Result<std::size_t> {
+        ScopedBus<spi::ISpi> spiGuard(spi, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.transfer(txBytes, rxBytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of ISpi::transfer(). Device is acquired by the worker thread for the duration of
+/// the operation.
+/// @see ISpi::transfer().
+inline auto transfer(spi::ISpi& spi,
+                     const spi::SpiDevice& device,
+                     const std::uint8_t* txBytes,
+                     std::uint8_t* rxBytes,
+                     std::size_t size,
+                     std::chrono::milliseconds timeout = cInfinity)
+{
+    auto function = [=, &spi, &device](osal::Timeout timeout) -> Result<std::size_t> {
+        spi::ScopedSpi spiGuard(spi, device, std::defer_lock);
+        if (auto error = spiGuard.acquire(timeout))
+            return error;
+
+        return spi.transfer(txBytes, rxBytes, size, timeout);
+    };
+
+    return makeOperation(std::move(function), timeout);
+}
+
+/// Awaitable version of IUart::write().
+/// @see IUart::write().
+inline auto write(uart::IUart& uart, const std::uint8_t* bytes, std::size_t size)
+{
+    return makeOperation([=, &uart](osal::Timeout /*timeout*/) { return uart.write(bytes, size); });
+}
+
+/// Awaitable version of IUart::read().
+/// @see IUart::read().
+inline auto read(uart::IUart& uart, std::uint8_t* bytes, std::size_t size, std::chrono::milliseconds timeout)
+{
+    return makeOperation([=, &uart](osal::Timeout timeout) { return uart.read(bytes, size, timeout); }, timeout);
+}
+
+} // namespace hal::async
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/i2c/II2c.hpp"
+#include "hal/types.hpp"
+
+#include <osal/Semaphore.hpp>
+#include <osal/Thread.hpp>
+#include <osal/Timeout.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace hal::i2c {
+
+/// Represents the callback invoked after the asynchronous I2C transaction has been completed.
+using CompletionCallback = std::function<void(std::error_code)>;
+
+/// Represents a single transaction submitted to the AsyncI2c.
+/// @note Messages and all data buffers referenced by them must remain valid until the callback is invoked.
+struct I2cTransaction {
+    const I2cMessage* messages{};
+    std::size_t count{};
+    osal::Timeout timeout{osal::Timeout::infinity()};
+    CompletionCallback callback;
+};
+
+/// Represents the asynchronous front-end of the II2c bus. Transactions submitted by many producers are stored in
+/// the bounded queue and executed by the dedicated bus worker, which locks the bus once per batch of queued
+/// transactions instead of once per transaction.
+/// @note Underlying II2c device must be opened before the worker is started.
+class AsyncI2c {
+public:
+    /// Constructor.
+    /// @param i2c              I2C bus to be used by the worker.
+    /// @param queueSize        Maximal number of transactions waiting for execution.
+    /// @param lockTimeout      Maximal time to wait for the I2C bus before each batch (measured separately for each
+    ///                         batch).
+    AsyncI2c(std::shared_ptr<II2c> i2c,
+             std::size_t queueSize,
+             std::chrono::milliseconds lockTimeout = cInfiniteTimeout);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because AsyncI2c is not meant to be copy-constructed.
+    AsyncI2c(const AsyncI2c&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because AsyncI2c is not meant to be move-constructed.
+    AsyncI2c(AsyncI2c&&) = delete;
+
+    /// Destructor.
+    /// @note This destructor automatically stops the worker.
+    ~AsyncI2c();
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because AsyncI2c is not meant to be copy-assigned.
+    AsyncI2c& operator=(const AsyncI2c&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because AsyncI2c is not meant to be move-assigned.
+    AsyncI2c& operator=(AsyncI2c&&) = delete;
+
+    /// Starts the bus worker.
+    /// @return Error code of the operation.
+    std::error_code start();
+
+    /// Stops the bus worker. Transactions, which were not executed yet, are completed with Error::eWrongState.
+    /// @note Transactions submitted concurrently with stop() are either completed this way or rejected by submit().
+    /// @return Error code of the operation.
+    std::error_code stop();
+
+    /// Checks if the bus worker is running.
+    /// @return Flag indicating if the bus worker is running.
+    /// @retval true            Worker is running.
+    /// @retval false           Worker is not running.
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /// Enqueues given transaction for the asynchronous execution.
+    /// @param transaction      Transaction to be executed.
+    /// @param timeout          Maximal time to wait for the free slot in the queue.
+    /// @return Error code of the operation.
+    /// @note Callback is invoked from the worker thread while the bus is still locked, so it must not perform
+    ///       any blocking I2C operations. It may however submit new transactions, but only with zero timeout,
+    ///       because the worker is the only one freeing the slots, so waiting for a slot from the callback would
+    ///       deadlock the worker if the queue is full.
+    std::error_code submit(I2cTransaction transaction, osal::Timeout timeout = osal::Timeout::infinity());
+
+private:
+    /// Main loop of the bus worker.
+    void worker();
+
+    /// Pops the oldest transaction from the queue.
+    /// @param transaction      Transaction object, where the popped transaction will be placed.
+    /// @return Flag indicating if the transaction has been popped.
+    /// @retval true            Transaction has been popped.
+    /// @retval false           Queue was empty (e.g. the worker has been woken up by stop()).
+    bool pop(I2cTransaction& transaction);
+
+    /// Executes given transaction and invokes its callback.
+    /// @param transaction      Transaction to be executed.
+    void execute(I2cTransaction& transaction);
+
+private:
+    std::shared_ptr<II2c> m_i2c;
+    std::chrono::milliseconds m_lockTimeout;
+    std::vector<I2cTransaction> m_queue;
+    std::size_t m_head{};
+    std::size_t m_tail{};
+    std::size_t m_count{};
+    osal::Mutex m_mutex;
+    osal::Semaphore m_freeSlots;
+    osal::Semaphore m_usedSlots{0};
+    std::atomic<bool> m_running{};
+    osal::Thread<> m_thread;
+};
+
+} // namespace hal::i2c
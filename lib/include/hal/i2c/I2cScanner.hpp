@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/i2c/II2c.hpp"
+#include "hal/types.hpp"
+
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace hal::i2c {
+
+/// Represents the I2C bus scanner, which detects devices present on the bus and caches the result. The cached
+/// presence map can be serialized (e.g. to IEeprom), so that after reboot it can be restored without rescanning
+/// the bus.
+/// @note Bus has to be locked by the caller for the time of scan().
+/// @note Addressing mode is taken from the bus parameters (see II2c::setParams()), so the bus has to be switched
+///       to the 10-bit addressing mode before scanning the 10-bit devices.
+class I2cScanner {
+public:
+    /// Constructor.
+    /// @param i2c              I2C bus to be scanned.
+    explicit I2cScanner(std::shared_ptr<II2c> i2c);
+
+    /// Probes all valid addresses and updates the cached presence map.
+    /// @param probeTimeout     Maximal time to wait for each single probe.
+    /// @return Error code of the operation.
+    /// @note In the 7-bit addressing mode reserved addresses (0x00-0x07 and 0x78-0x7f) are skipped.
+    std::error_code scan(std::chrono::milliseconds probeTimeout);
+
+    /// Probes the single address and updates its entry in the cached presence map.
+    /// @param address          Address of the I2C slave device.
+    /// @param probeTimeout     Maximal time to wait for the probe.
+    /// @return Flag indicating if the device is present on the bus.
+    /// @note If the addressing mode of the bus has changed since the last scan, then the cached presence map is
+    ///       invalidated first.
+    bool rescan(std::uint16_t address, std::chrono::milliseconds probeTimeout);
+
+    /// Checks in the cached presence map if the given device is present on the bus.
+    /// @param address          Address of the I2C slave device.
+    /// @return Flag indicating if the device is present on the bus.
+    /// @retval true            Device has been detected during the last scan.
+    /// @retval false           Device has not been detected or the bus has not been scanned yet.
+    [[nodiscard]] bool isPresent(std::uint16_t address) const;
+
+    /// Checks if the cached presence map is valid (either scanned or restored).
+    /// @return Flag indicating if the cached presence map is valid.
+    /// @retval true            Presence map is valid.
+    /// @retval false           Presence map is not valid.
+    [[nodiscard]] bool isValid() const { return m_valid; }
+
+    /// Returns addresses of all devices from the cached presence map.
+    /// @return Addresses of all devices from the cached presence map.
+    [[nodiscard]] std::vector<std::uint16_t> devices() const;
+
+    /// Invalidates the cached presence map.
+    void clear();
+
+    /// Serializes the cached presence map.
+    /// @return Serialized presence map.
+    [[nodiscard]] BytesVector serialize() const;
+
+    /// Restores the cached presence map from the serialized form.
+    /// @param bytes            Serialized presence map.
+    /// @return Error code of the operation.
+    /// @note Presence map is accepted only if it has been scanned in the current addressing mode of the bus.
+    std::error_code deserialize(std::span<const std::uint8_t> bytes);
+
+private:
+    static constexpr std::size_t m_cMaxAddresses = 1024;
+    static constexpr std::uint8_t m_cFormatVersion = 1;
+
+    std::shared_ptr<II2c> m_i2c;
+    AddressingMode m_addressingMode{AddressingMode::e7bit};
+    std::bitset<m_cMaxAddresses> m_present;
+    bool m_valid{};
+};
+
+} // namespace hal::i2c
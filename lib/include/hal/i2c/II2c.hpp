@@ -33,6 +33,11 @@
 
 #pragma once
 
+#include "hal/BusArbiter.hpp"
+#include "hal/BusOwner.hpp"
+#include "hal/DmaBuffer.hpp"
+#include "hal/Error.hpp"
+#include "hal/TransferTracer.hpp"
 #include "hal/types.hpp"
 
 #include <osal/Mutex.hpp>
@@ -40,8 +45,13 @@
 #include <utils/registry/GlobalRegistry.hpp>
 #include <utils/types/Result.hpp>
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <system_error>
 
 namespace hal::i2c {
@@ -59,6 +69,51 @@ enum class AddressingMode {
 /// @retval false               Given address is invalid.
 bool verifyAddress(AddressingMode addressingMode, std::uint16_t address);
 
+/// Standard-mode I2C bus frequency.
+constexpr std::uint32_t cStandardModeHz = 100'000;
+
+/// Fast-mode I2C bus frequency.
+constexpr std::uint32_t cFastModeHz = 400'000;
+
+/// Fast-mode Plus I2C bus frequency.
+constexpr std::uint32_t cFastModePlusHz = 1'000'000;
+
+/// High-speed mode I2C bus frequency.
+constexpr std::uint32_t cHighSpeedModeHz = 3'400'000;
+
+/// Represents I2C parameters that can be set by each driver, which uses I2C.
+/// @note Bus recovery is configured per transfer with RetryPolicy::recoverBus.
+/// @note addressingMode defines how the addresses passed to the transfers are interpreted.
+struct I2cParams {
+    std::uint32_t frequencyHz{cStandardModeHz};
+    std::chrono::microseconds clockStretchTimeout{};
+    AddressingMode addressingMode{AddressingMode::e7bit};
+};
+
+/// Represents the policy of retrying the failed I2C transfers. Transfers failed with Error::eArbitrationLost are
+/// always retried, transfers failed with Error::eNack are retried only if retryOnNack is set (e.g. for EEPROMs,
+/// which don't acknowledge during the write cycle). Transfers failed with Error::eTimeout or Error::eHardwareError
+/// are retried only if recoverBus is set and bus recovery succeeded. Other errors are never retried.
+/// @note Backoff between the attempts starts at initialBackoff and is doubled after each attempt up to maxBackoff.
+struct RetryPolicy {
+    std::uint32_t maxAttempts{1};
+    std::chrono::microseconds initialBackoff{};
+    std::chrono::microseconds maxBackoff{};
+    bool retryOnNack{};
+    bool recoverBus{};
+};
+
+/// Represents a single segment (message) of the combined I2C transaction. Each message is either a write or a read,
+/// depending on which of the data pointers is set. Consecutive messages are separated by the repeated start condition
+/// and the stop condition is generated only after the last message.
+/// @note This is the equivalent of the Linux i2c_msg structure used with the I2C_RDWR ioctl.
+struct I2cMessage {
+    std::uint16_t address{};
+    const std::uint8_t* txBytes{};
+    std::uint8_t* rxBytes{};
+    std::size_t size{};
+};
+
 /// Represents the I2C bus controller. There should be one instance for each bus.
 class II2c {
 public:
@@ -100,10 +155,42 @@ public:
     ///       each transfer.
     std::error_code close();
 
+    /// Sets the transmission parameters.
+    /// @param params           Set of transmission parameters.
+    /// @return Error code of the operation.
+    /// @note Zero clockStretchTimeout means that the driver default should be used.
+    std::error_code setParams(I2cParams params);
+
+    /// Returns the transmission parameters set by the last successful call to setParams().
+    /// @return Transmission parameters (defaults if setParams() has never succeeded).
+    [[nodiscard]] const I2cParams& params() const { return m_params; }
+
+    /// Sets the policy of retrying the failed transfers. By default failed transfers are not retried.
+    /// @param retryPolicy      Policy to be used.
+    void setRetryPolicy(RetryPolicy retryPolicy) { m_retryPolicy = retryPolicy; }
+
+    /// Sets the tracer, which records all transfers and the time spent waiting for the bus lock.
+    /// @param tracer           Tracer to be used (nullptr disables tracing).
+    /// @note Tracer can be shared between many buses.
+    void setTracer(std::shared_ptr<TransferTracer> tracer) { m_tracer = std::move(tracer); }
+
+    /// Sets the arbiter, which grants the bus to the clients according to their priorities.
+    /// @param arbiter           Arbiter to be used (nullptr means plain mutex locking).
+    /// @note Arbiter must be set before the bus is used by multiple clients and must not be changed while the bus
+    ///       is locked.
+    void setArbiter(std::shared_ptr<BusArbiter> arbiter) { m_arbiter = std::move(arbiter); }
+
+    /// Performs the bus recovery procedure (e.g. 9 clock pulses followed by the stop condition), which releases
+    /// the SDA line held low by one of the slaves.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code recoverBus(osal::Timeout timeout);
+
     /// Locks the I2C bus for the current device.
     /// @param timeout          Maximal time to wait for the bus in ms.
+    /// @param priority         Priority of the bus access (used only if the arbiter is set).
     /// @return Error code of the operation.
-    std::error_code lock(osal::Timeout timeout);
+    std::error_code lock(osal::Timeout timeout, BusPriority priority = BusPriority::eNormal);
 
     /// Unlocks the I2C bus.
     /// @return Error code of the operation.
@@ -127,6 +214,22 @@ public:
     std::error_code
     write(std::uint16_t address, const std::uint8_t* bytes, std::size_t size, bool stop, osal::Timeout timeout);
 
+    /// Transmits given span of bytes to the current I2C device.
+    /// @param address          Address of the I2C slave device.
+    /// @param bytes            Span of raw bytes to be transmitted.
+    /// @param stop             Flag indicating if stop condition should be generated after the transfer.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(std::uint16_t address, std::span<const std::uint8_t> bytes, bool stop, osal::Timeout timeout);
+
+    /// Transmits given DMA buffer to the current I2C device. Drivers can use the buffer directly as the DMA source.
+    /// @param address          Address of the I2C slave device.
+    /// @param buffer           DMA buffer to be transmitted.
+    /// @param stop             Flag indicating if stop condition should be generated after the transfer.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(std::uint16_t address, const DmaBuffer& buffer, bool stop, osal::Timeout timeout);
+
     /// Receives demanded number of bytes from the current I2C device.
     /// @param address          Address of the I2C slave device.
     /// @param size             Number of bytes to be received.
@@ -134,6 +237,15 @@ public:
     /// @return Received data or error code of the operation.
     Result<BytesVector> read(std::uint16_t address, std::size_t size, osal::Timeout timeout);
 
+    /// Receives demanded number of bytes from the current I2C device.
+    /// @param address          Address of the I2C slave device.
+    /// @param size             Number of bytes to be received.
+    /// @param resource         Memory resource (e.g. hal::BufferPool) used to allocate the output vector.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Received data or error code of the operation.
+    Result<PooledBytesVector>
+    read(std::uint16_t address, std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout);
+
     /// Receives demanded number of bytes from the current I2C device.
     /// @param address          Address of the I2C slave device.
     /// @param bytes            Memory block where the received data will be placed by this method.
@@ -142,12 +254,114 @@ public:
     /// @return Number of received bytes or error code of the operation.
     Result<std::size_t> read(std::uint16_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Receives demanded number of bytes from the current I2C device.
+    /// @param address          Address of the I2C slave device.
+    /// @param bytes            Span where the received data will be placed by this method. Its size defines
+    ///                         the number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(std::uint16_t address, std::span<std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Receives data from the current I2C device into the given DMA buffer. Drivers can use the buffer directly
+    /// as the DMA destination.
+    /// @param address          Address of the I2C slave device.
+    /// @param buffer           DMA buffer where the received data will be placed. Its size defines the number
+    ///                         of bytes to be received.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(std::uint16_t address, DmaBuffer& buffer, osal::Timeout timeout);
+
+    /// Receives the compile-time known number of bytes from the current I2C device without any heap allocation.
+    /// @tparam cSize           Number of bytes to be received.
+    /// @param address          Address of the I2C slave device.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Array with received data or error code of the operation.
+    /// @note Receiving less than cSize bytes is reported as Error::eHardwareError.
+    template <std::size_t cSize>
+    Result<std::array<std::uint8_t, cSize>> read(std::uint16_t address, osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, cSize> bytes{};
+        auto [actualReadSize, error] = read(address, bytes.data(), bytes.size(), timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != cSize)
+            return Error::eHardwareError;
+
+        return bytes;
+    }
+
+    /// Transmits given vector of bytes to the current I2C device and then, after the repeated start condition,
+    /// receives demanded number of bytes from the same device.
+    /// @param address          Address of the I2C slave device.
+    /// @param txBytes          Vector of raw bytes to be transmitted (e.g. register address).
+    /// @param rxSize           Number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Received data or error code of the operation.
+    Result<BytesVector>
+    writeRead(std::uint16_t address, const BytesVector& txBytes, std::size_t rxSize, osal::Timeout timeout);
+
+    /// Transmits given memory block of bytes to the current I2C device and then, after the repeated start condition,
+    /// receives demanded number of bytes from the same device.
+    /// @param address          Address of the I2C slave device.
+    /// @param txBytes          Memory block of raw bytes to be transmitted (e.g. register address).
+    /// @param txSize           Size of the memory block to be transmitted.
+    /// @param rxBytes          Memory block where the received data will be placed by this method.
+    /// @param rxSize           Number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> writeRead(std::uint16_t address,
+                                  const std::uint8_t* txBytes,
+                                  std::size_t txSize,
+                                  std::uint8_t* rxBytes,
+                                  std::size_t rxSize,
+                                  osal::Timeout timeout);
+
+    /// Transmits given span of bytes to the current I2C device and then, after the repeated start condition,
+    /// receives demanded number of bytes from the same device.
+    /// @param address          Address of the I2C slave device.
+    /// @param txBytes          Span of raw bytes to be transmitted (e.g. register address).
+    /// @param rxBytes          Span where the received data will be placed by this method. Its size defines
+    ///                         the number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> writeRead(std::uint16_t address,
+                                  std::span<const std::uint8_t> txBytes,
+                                  std::span<std::uint8_t> rxBytes,
+                                  osal::Timeout timeout);
+
+    /// Performs the combined I2C transaction consisting of the given messages. Messages are separated by the repeated
+    /// start condition and the stop condition is generated only after the last one.
+    /// @param messages         Array of messages to be transferred.
+    /// @param count            Number of messages in the array.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Error code of the operation.
+    std::error_code transfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout);
+
+    /// Performs the combined I2C transaction consisting of the given messages. Messages are separated by the repeated
+    /// start condition and the stop condition is generated only after the last one.
+    /// @param messages         Span of messages to be transferred.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Error code of the operation.
+    std::error_code transfer(std::span<const I2cMessage> messages, osal::Timeout timeout);
+
+    /// Checks if the I2C slave device with the given address acknowledges its address on the bus.
+    /// @param address          Address of the I2C slave device.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    /// @retval Error::eOk      Device is present on the bus.
+    std::error_code probe(std::uint16_t address, osal::Timeout timeout);
+
 private:
-    /// Checks if the I2C bus is locked.
+    /// Checks if the I2C bus is locked by the calling thread.
     /// @return Flag indicating if the I2C bus is locked.
-    /// @retval true            Bus is opened.
-    /// @retval false           Bus is not opened.
-    bool isLocked();
+    /// @retval true            Bus is locked.
+    /// @retval false           Bus is not locked.
+    /// @note This check is lock-free if HAL_THREAD_OWNERSHIP is defined (see BusOwner).
+    [[nodiscard]] bool isLocked() const
+    {
+        return m_owner.isOwner(m_mutex);
+    }
 
     /// Checks if the device is opened.
     /// @return Flag indicating if the device is opened.
@@ -160,6 +374,14 @@ private:
     /// @return Error code of the operation.
     std::error_code checkState();
 
+    /// Executes the given operation according to the current retry policy.
+    /// @tparam Operation       Type of the callable performing the operation.
+    /// @param operation        Callable performing the operation and returning its error code.
+    /// @param timeout          Maximal time for all attempts.
+    /// @return Error code of the last attempt.
+    template <typename Operation>
+    std::error_code withRetry(Operation operation, osal::Timeout timeout);
+
     /// Driver specific implementation of opening the transmission channel. If the configuration of this device is
     /// valid, then after a successful call to this method device will be able to transmit data according
     /// to the settings.
@@ -171,6 +393,13 @@ private:
     /// @return Error code of the operation.
     virtual std::error_code drvClose() = 0;
 
+    /// Driver specific implementation of setting the transmission params.
+    /// @param params           Set of transmission parameters.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported, so that drivers working with the fixed bus
+    ///       configuration don't need to implement it.
+    virtual std::error_code drvSetParams(I2cParams params);
+
     /// Driver specific implementation of sending the memory block of bytes.
     /// @param address          Address of the I2C slave device.
     /// @param bytes            Memory block of raw bytes to be transmitted.
@@ -191,11 +420,59 @@ private:
     virtual Result<std::size_t>
     drvRead(std::uint16_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) = 0;
 
+    /// Driver specific implementation of sending the DMA buffer.
+    /// @param address          Address of the I2C slave device.
+    /// @param buffer           DMA buffer to be transmitted.
+    /// @param stop             Flag indicating if stop condition should be generated after the transfer.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    /// @note Default implementation calls drvWrite(). Drivers using DMA should override this method to skip
+    ///       the bounce buffer, because DmaBuffer guarantees the alignment and cache line ownership.
+    virtual std::error_code
+    drvWriteDma(std::uint16_t address, const DmaBuffer& buffer, bool stop, osal::Timeout timeout);
+
+    /// Driver specific implementation of reading into the DMA buffer.
+    /// @param address          Address of the I2C slave device.
+    /// @param buffer           DMA buffer where the received data will be placed.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    /// @note Default implementation calls drvRead(). Drivers using DMA should override this method to skip
+    ///       the bounce buffer, because DmaBuffer guarantees the alignment and cache line ownership.
+    virtual Result<std::size_t> drvReadDma(std::uint16_t address, DmaBuffer& buffer, osal::Timeout timeout);
+
+    /// Driver specific implementation of the combined I2C transaction.
+    /// @param messages         Array of messages to be transferred.
+    /// @param count            Number of messages in the array.
+    /// @param timeout          Maximal time to wait for the whole transaction.
+    /// @return Error code of the operation.
+    /// @note Default implementation falls back to the sequence of drvWrite() and drvRead() calls, so repeated start
+    ///       is guaranteed only after the write messages. Drivers, which are able to submit the whole transaction as
+    ///       one operation (e.g. I2C_RDWR ioctl or chained DMA), should override this method.
+    virtual std::error_code drvTransfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout);
+
+    /// Driver specific implementation of checking if the I2C slave device is present on the bus.
+    /// @param address          Address of the I2C slave device.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    /// @note Default implementation reads one byte from the device. Drivers, which support zero-length writes
+    ///       (SMBus quick command), should override this method, because such probe doesn't clock any data.
+    virtual std::error_code drvProbe(std::uint16_t address, osal::Timeout timeout);
+
+    /// Driver specific implementation of the bus recovery procedure.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvRecoverBus(osal::Timeout timeout);
+
 private:
     std::uint32_t m_userCount{};
     bool m_opened{};
-    bool m_locked{};
-    osal::Mutex m_mutex{OsalMutexType::eRecursive};
+    BusOwner m_owner;
+    mutable osal::Mutex m_mutex{OsalMutexType::eRecursive};
+    I2cParams m_params;
+    RetryPolicy m_retryPolicy;
+    std::shared_ptr<TransferTracer> m_tracer;
+    std::shared_ptr<BusArbiter> m_arbiter;
 };
 
 /// Represents GlobalRegistry of II2c instances.
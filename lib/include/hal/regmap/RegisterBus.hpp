@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/Error.hpp"
+#include "hal/i2c/II2c.hpp"
+#include "hal/spi/ISpi.hpp"
+
+#include <osal/Timeout.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+namespace hal::regmap {
+
+/// Represents the adapter translating raw register accesses into the transfers of the given bus type.
+/// @tparam Bus             Type of the bus used to access the registers.
+/// @note Only specializations of this template are meant to be used.
+template <typename Bus>
+class RegisterBus;
+
+/// Represents the register access over the I2C bus. Registers are written as [address][values] in a single write
+/// and read as [address] write followed by the repeated start and read of the values.
+template <>
+class RegisterBus<i2c::II2c> {
+public:
+    /// Constructor.
+    /// @param i2c              I2C bus to be used.
+    /// @param address          Address of the I2C slave device.
+    RegisterBus(std::shared_ptr<i2c::II2c> i2c, std::uint16_t address)
+        : m_i2c(std::move(i2c))
+        , m_address(address)
+    {}
+
+    /// Writes the given memory block consisting of the register address followed by the register values.
+    /// @param bytes            Memory block to be written.
+    /// @param size             Size of the memory block.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(const std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
+    {
+        return m_i2c->write(m_address, bytes, size, true, timeout);
+    }
+
+    /// Reads the values of the registers starting at the given register address.
+    /// @param addressBytes     Encoded register address.
+    /// @param addressSize      Size of the encoded register address.
+    /// @param bytes            Memory block where the register values will be placed.
+    /// @param size             Number of bytes to be read.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Number of read bytes or error code of the operation.
+    Result<std::size_t> read(const std::uint8_t* addressBytes,
+                             std::size_t addressSize,
+                             std::uint8_t* bytes,
+                             std::size_t size,
+                             osal::Timeout timeout)
+    {
+        return m_i2c->writeRead(m_address, addressBytes, addressSize, bytes, size, timeout);
+    }
+
+    /// Returns the mask to be applied to the first byte of the register address in the write access.
+    /// @return Mask to be applied to the first byte of the register address in the write access.
+    [[nodiscard]] std::uint8_t writeFlag() const { return 0; }
+
+private:
+    std::shared_ptr<i2c::II2c> m_i2c;
+    std::uint16_t m_address;
+};
+
+/// Represents the register access over the SPI bus. Direction of the access is encoded in the first byte
+/// of the register address with the configurable flags (e.g. MSB set for read).
+/// @note Chip select driven by GPIO must be kept enabled for the whole access (e.g. with ScopedSpi).
+template <>
+class RegisterBus<spi::ISpi> {
+public:
+    /// Default mask applied to the first address byte in the read access.
+    static constexpr std::uint8_t cDefaultReadFlag = 0x80;
+
+    /// Constructor.
+    /// @param spi              SPI bus to be used.
+    /// @param readFlag         Mask applied to the first byte of the register address in the read access.
+    /// @param writeFlag        Mask applied to the first byte of the register address in the write access.
+    explicit RegisterBus(std::shared_ptr<spi::ISpi> spi,
+                         std::uint8_t readFlag = cDefaultReadFlag,
+                         std::uint8_t writeFlag = 0)
+        : m_spi(std::move(spi))
+        , m_readFlag(readFlag)
+        , m_writeFlag(writeFlag)
+    {}
+
+    /// @see RegisterBus<i2c::II2c>::write().
+    std::error_code write(const std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
+    {
+        return m_spi->write(bytes, size, timeout);
+    }
+
+    /// @see RegisterBus<i2c::II2c>::read().
+    Result<std::size_t> read(const std::uint8_t* addressBytes,
+                             std::size_t addressSize,
+                             std::uint8_t* bytes,
+                             std::size_t size,
+                             osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, sizeof(std::uint64_t)> command{};
+        if (addressSize == 0 || addressSize > command.size())
+            return Error::eInvalidArgument;
+
+        std::copy_n(addressBytes, addressSize, command.begin());
+        command[0] |= m_readFlag;
+
+        // Address and data phases are submitted as one transaction, so that drivers with the hardware chip select
+        // (e.g. LinuxSpi) don't release it between them.
+        std::array<spi::SpiSegment, 2> segments{};
+        segments[0].txBytes = command.data();
+        segments[0].size = addressSize;
+        segments[1].rxBytes = bytes;
+        segments[1].size = size;
+        if (auto error = m_spi->transfer(segments.data(), segments.size(), timeout))
+            return error;
+
+        return size;
+    }
+
+    /// @see RegisterBus<i2c::II2c>::writeFlag().
+    [[nodiscard]] std::uint8_t writeFlag() const { return m_writeFlag; }
+
+private:
+    std::shared_ptr<spi::ISpi> m_spi;
+    std::uint8_t m_readFlag;
+    std::uint8_t m_writeFlag;
+};
+
+} // namespace hal::regmap
@@ -0,0 +1,272 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/Error.hpp"
+#include "hal/regmap/RegisterBus.hpp"
+
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hal::regmap {
+
+/// Represents the map of registers of the I2C/SPI peripheral with the shadow cache of the register values.
+/// Non-volatile registers are read from the bus only once and writes to them are deferred until flush(), which
+/// coalesces contiguous dirty registers into single burst writes. Volatile registers (e.g. status or data registers)
+/// are never cached. Multi-byte addresses and values are transmitted in big-endian order.
+/// @tparam Bus             Type of the bus used to access the registers (II2c or ISpi).
+/// @tparam AddrWidth       Unsigned type representing the width of the register address.
+/// @tparam ValueWidth      Unsigned type representing the width of the register value.
+/// @note Bus has to be locked (and chip select enabled) by the caller for the time of each bus access.
+template <typename Bus, typename AddrWidth, typename ValueWidth>
+class RegisterMap {
+    static_assert(std::is_unsigned_v<AddrWidth> && sizeof(AddrWidth) <= sizeof(std::uint64_t));
+    static_assert(std::is_unsigned_v<ValueWidth> && sizeof(ValueWidth) <= sizeof(std::uint64_t));
+
+public:
+    /// Constructor.
+    /// @param bus              Bus adapter used to access the registers.
+    /// @param registerCount    Number of registers in the map (valid addresses are 0..registerCount-1).
+    RegisterMap(RegisterBus<Bus> bus, std::size_t registerCount)
+        : m_bus(std::move(bus))
+        , m_values(registerCount)
+        , m_flags(registerCount)
+        , m_buffer(sizeof(AddrWidth) + registerCount * sizeof(ValueWidth))
+    {}
+
+    /// Marks the given register as volatile (never cached) or non-volatile.
+    /// @param reg              Address of the register.
+    /// @param isVolatile       Flag indicating if the register is volatile.
+    /// @return Error code of the operation.
+    /// @note Register with the deferred write has to be flushed before it can be marked as volatile.
+    std::error_code setVolatile(AddrWidth reg, bool isVolatile)
+    {
+        if (reg >= m_flags.size())
+            return Error::eInvalidArgument;
+
+        if (!isVolatile) {
+            m_flags[reg] &= std::uint8_t(~m_cVolatile);
+            return Error::eOk;
+        }
+
+        if ((m_flags[reg] & m_cDirty) != 0)
+            return Error::eWrongState;
+
+        m_flags[reg] = m_cVolatile;
+        return Error::eOk;
+    }
+
+    /// Reads the value of the given register. Non-volatile registers are served from the cache if possible.
+    /// @param reg              Address of the register.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Value of the register or error code of the operation.
+    Result<ValueWidth> read(AddrWidth reg, osal::Timeout timeout)
+    {
+        if (reg >= m_flags.size())
+            return Error::eInvalidArgument;
+
+        if ((m_flags[reg] & m_cCached) != 0)
+            return m_values[reg];
+
+        auto addressSize = encode(reg);
+        std::uint8_t* valueBytes = m_buffer.data() + addressSize;
+        auto [actualReadSize, error]
+            = m_bus.read(m_buffer.data(), addressSize, valueBytes, sizeof(ValueWidth), timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != sizeof(ValueWidth))
+            return Error::eHardwareError;
+
+        ValueWidth value = decode(valueBytes);
+        if ((m_flags[reg] & m_cVolatile) == 0) {
+            m_values[reg] = value;
+            m_flags[reg] |= m_cCached;
+        }
+
+        return value;
+    }
+
+    /// Writes the value to the given register. Writes to non-volatile registers are deferred until flush().
+    /// @param reg              Address of the register.
+    /// @param value            Value to be written.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(AddrWidth reg, ValueWidth value, osal::Timeout timeout)
+    {
+        if (reg >= m_flags.size())
+            return Error::eInvalidArgument;
+
+        if ((m_flags[reg] & m_cVolatile) != 0)
+            return writeBurst(reg, &value, 1, timeout);
+
+        if ((m_flags[reg] & m_cCached) != 0 && m_values[reg] == value)
+            return Error::eOk;
+
+        m_values[reg] = value;
+        m_flags[reg] |= (m_cCached | m_cDirty);
+        return Error::eOk;
+    }
+
+    /// Performs the read-modify-write operation on the given register.
+    /// @param reg              Address of the register.
+    /// @param mask             Mask of bits to be modified.
+    /// @param value            New value of the masked bits.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code update(AddrWidth reg, ValueWidth mask, ValueWidth value, osal::Timeout timeout)
+    {
+        auto [current, error] = read(reg, timeout);
+        if (error)
+            return error;
+
+        auto newValue = static_cast<ValueWidth>((*current & ValueWidth(~mask)) | (value & mask));
+        return write(reg, newValue, timeout);
+    }
+
+    /// Writes all dirty registers to the device. Contiguous dirty registers are written in a single burst.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code flush(osal::Timeout timeout)
+    {
+        std::size_t reg = 0;
+        while (reg < m_flags.size()) {
+            if ((m_flags[reg] & m_cDirty) == 0) {
+                ++reg;
+                continue;
+            }
+
+            std::size_t count = 1;
+            while ((reg + count) < m_flags.size() && (m_flags[reg + count] & m_cDirty) != 0)
+                ++count;
+
+            if (auto error = writeBurst(static_cast<AddrWidth>(reg), &m_values[reg], count, timeout))
+                return error;
+
+            for (std::size_t i = reg; i < reg + count; ++i)
+                m_flags[i] &= std::uint8_t(~m_cDirty);
+
+            reg += count;
+        }
+
+        return Error::eOk;
+    }
+
+    /// Checks if there are any registers waiting to be written by flush().
+    /// @return Flag indicating if there are any dirty registers.
+    /// @retval true            There are dirty registers.
+    /// @retval false           There are no dirty registers.
+    [[nodiscard]] bool isDirty() const
+    {
+        for (auto flags : m_flags) {
+            if ((flags & m_cDirty) != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    /// Drops all cached values, including the dirty ones (e.g. after the device reset).
+    void invalidate()
+    {
+        for (auto& flags : m_flags)
+            flags &= m_cVolatile;
+    }
+
+private:
+    /// Encodes the given register address into the internal buffer.
+    /// @param reg              Address of the register.
+    /// @return Size of the encoded address.
+    std::size_t encode(AddrWidth reg)
+    {
+        for (std::size_t i = 0; i < sizeof(AddrWidth); ++i) {
+            auto shift = m_cBitsPerByte * (sizeof(AddrWidth) - 1 - i);
+            m_buffer[i] = static_cast<std::uint8_t>(std::uint64_t(reg) >> shift);
+        }
+
+        return sizeof(AddrWidth);
+    }
+
+    /// Decodes the register value from the given memory block.
+    /// @param bytes            Memory block with the big-endian register value.
+    /// @return Decoded register value.
+    static ValueWidth decode(const std::uint8_t* bytes)
+    {
+        std::uint64_t value{};
+        for (std::size_t i = 0; i < sizeof(ValueWidth); ++i)
+            value = (value << m_cBitsPerByte) | bytes[i];
+
+        return static_cast<ValueWidth>(value);
+    }
+
+    /// Writes the given values to the contiguous block of registers in a single bus transfer.
+    /// @param reg              Address of the first register.
+    /// @param values           Values to be written.
+    /// @param count            Number of values to be written.
+    /// @param timeout          Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code writeBurst(AddrWidth reg, const ValueWidth* values, std::size_t count, osal::Timeout timeout)
+    {
+        auto size = encode(reg);
+        m_buffer[0] |= m_bus.writeFlag();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t j = 0; j < sizeof(ValueWidth); ++j) {
+                auto shift = m_cBitsPerByte * (sizeof(ValueWidth) - 1 - j);
+                m_buffer[size++] = static_cast<std::uint8_t>(std::uint64_t(values[i]) >> shift);
+            }
+        }
+
+        return m_bus.write(m_buffer.data(), size, timeout);
+    }
+
+private:
+    static constexpr std::size_t m_cBitsPerByte = 8;
+    static constexpr std::uint8_t m_cVolatile = 0x01;
+    static constexpr std::uint8_t m_cCached = 0x02;
+    static constexpr std::uint8_t m_cDirty = 0x04;
+
+    RegisterBus<Bus> m_bus;
+    std::vector<ValueWidth> m_values;
+    std::vector<std::uint8_t> m_flags;
+    std::vector<std::uint8_t> m_buffer;
+};
+
+} // namespace hal::regmap
@@ -33,6 +33,11 @@
 
 #pragma once
 
+#include "hal/BusArbiter.hpp"
+#include "hal/BusOwner.hpp"
+#include "hal/DmaBuffer.hpp"
+#include "hal/Error.hpp"
+#include "hal/TransferTracer.hpp"
 #include "hal/types.hpp"
 
 #include <osal/Mutex.hpp>
@@ -40,8 +45,14 @@
 #include <utils/registry/GlobalRegistry.hpp>
 #include <utils/types/Result.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <system_error>
 
 namespace hal::spi {
@@ -54,11 +65,76 @@ enum class Mode {
     eMode3
 };
 
+/// Represents the number of data lines used in the SPI transmission.
+enum class BusWidth : std::uint8_t {
+    eSingle = 1,
+    eDual = 2,
+    eQuad = 4,
+    eOctal = 8
+};
+
 /// Represents SPI parameters that can be set by each driver, which uses SPI.
+/// @note txWidth and rxWidth define the maximal bus widths allowed for the device. Width of the particular transfer
+///       is selected with SpiSegment or SpiMemOp.
+/// @note deviceId identifies the device (e.g. by its chip select number) in the transfer tracer. It doesn't affect
+///       the transmission, so changing only deviceId doesn't reconfigure the driver.
 struct SpiParams {
     std::uint32_t frequencyHz{};
     Mode clockMode{};
     std::uint8_t wordLength{};
+    BusWidth txWidth{BusWidth::eSingle};
+    BusWidth rxWidth{BusWidth::eSingle};
+    std::uint16_t deviceId{};
+
+    /// Equality operator.
+    /// @return Flag indicating if both sets of parameters are equal.
+    bool operator==(const SpiParams&) const = default;
+};
+
+/// Represents a single segment of the scatter-gather SPI transfer. Segment transmits txBytes (or zeros if txBytes
+/// is not set) and stores the response in rxBytes (or discards it if rxBytes is not set). All segments of the list
+/// are transferred within one chip select window, unless csChange is set for some of them.
+/// @note This is the equivalent of the Linux spi_ioc_transfer structure used with the SPI_IOC_MESSAGE ioctl.
+struct SpiSegment {
+    const std::uint8_t* txBytes{};
+    std::uint8_t* rxBytes{};
+    std::size_t size{};
+    std::uint32_t speedHz{};
+    bool csChange{};
+    BusWidth txWidth{BusWidth::eSingle};
+    BusWidth rxWidth{BusWidth::eSingle};
+};
+
+/// Represents the SPI memory operation (e.g. SPI NOR fast read), which consists of the command, address, dummy and
+/// data phases. Each phase can use a different bus width (e.g. 1-1-4 or 1-4-4 quad read). Phases with zero size
+/// are skipped. Address is transmitted MSB first.
+struct SpiMemOp {
+    std::uint8_t command{};
+    BusWidth commandWidth{BusWidth::eSingle};
+    std::uint32_t address{};
+    std::uint8_t addressSize{};
+    BusWidth addressWidth{BusWidth::eSingle};
+    std::uint8_t dummySize{};
+    BusWidth dummyWidth{BusWidth::eSingle};
+    const std::uint8_t* txData{};
+    std::uint8_t* rxData{};
+    std::size_t dataSize{};
+    BusWidth dataWidth{BusWidth::eSingle};
+};
+
+/// Represents the callback invoked by the driver after each streamed frame. It receives the index of the frame, which
+/// has just been filled, and returns the index of the frame to be filled next.
+/// @note Callback may be invoked from the interrupt context.
+using StreamCallback = std::function<std::size_t(std::size_t)>;
+
+/// Represents the ring of frames used in the SPI streaming mode. Frame i starts at frames + i * frameStride.
+struct SpiStreamRing {
+    const std::uint8_t* txFrame{};
+    std::uint8_t* frames{};
+    std::size_t frameSize{};
+    std::size_t frameStride{};
+    std::size_t frameCount{};
+    std::size_t firstFrame{};
 };
 
 /// Represents the SPI bus controller. There should be one instance for each bus.
@@ -105,12 +181,27 @@ public:
     /// Sets the transmission parameters.
     /// @param params               Set of transmission parameters.
     /// @return Error code of the operation.
+    /// @note Parameters are cached, so setting the same parameters as the currently programmed ones doesn't call
+    ///       the driver. Cache is invalidated when the device is opened or closed and when setting parameters fails.
     std::error_code setParams(SpiParams params);
 
+    /// Sets the tracer, which records all transfers and the time spent waiting for the bus lock.
+    /// @param tracer               Tracer to be used (nullptr disables tracing).
+    /// @note Tracer can be shared between many buses. Transfers are recorded with SpiParams::deviceId as
+    ///       the address.
+    void setTracer(std::shared_ptr<TransferTracer> tracer) { m_tracer = std::move(tracer); }
+
+    /// Sets the arbiter, which grants the bus to the clients according to their priorities.
+    /// @param arbiter               Arbiter to be used (nullptr means plain mutex locking).
+    /// @note Arbiter must be set before the bus is used by multiple clients and must not be changed while the bus
+    ///       is locked.
+    void setArbiter(std::shared_ptr<BusArbiter> arbiter) { m_arbiter = std::move(arbiter); }
+
     /// Locks the SPI bus for the current device.
     /// @param timeout              Maximal time to wait for the bus.
+    /// @param priority             Priority of the bus access (used only if the arbiter is set).
     /// @return Error code of the operation.
-    std::error_code lock(osal::Timeout timeout);
+    std::error_code lock(osal::Timeout timeout, BusPriority priority = BusPriority::eNormal);
 
     /// Unlocks the SPI bus.
     /// @return Error code of the operation.
@@ -129,12 +220,31 @@ public:
     /// @return Error code of the operation.
     std::error_code write(const std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Transmits given span of bytes to the SPI device.
+    /// @param bytes                Span of raw bytes to be transmitted.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(std::span<const std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Transmits given DMA buffer to the SPI device. Drivers can use the buffer directly as the DMA source.
+    /// @param buffer               DMA buffer to be transmitted.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    std::error_code write(const DmaBuffer& buffer, osal::Timeout timeout);
+
     /// Receives the demanded number of bytes from the SPI device.
     /// @param size                 Number of bytes to be received.
     /// @param timeoutMs            Maximal time to wait for the bus.
     /// @return Vector with received data or error code of the operation.
     Result<BytesVector> read(std::size_t size, osal::Timeout timeout);
 
+    /// Receives the demanded number of bytes from the SPI device.
+    /// @param size                 Number of bytes to be received.
+    /// @param resource             Memory resource (e.g. hal::BufferPool) used to allocate the output vector.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Vector with received data or error code of the operation.
+    Result<PooledBytesVector> read(std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout);
+
     /// Receives the demanded number of bytes from the SPI device.
     /// @param bytes                Memory block where the received data will be placed.
     /// @param size                 Number of bytes to be received.
@@ -142,12 +252,54 @@ public:
     /// @return Received data or error code of the operation.
     Result<std::size_t> read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Receives the demanded number of bytes from the SPI device.
+    /// @param bytes                Span where the received data will be placed. Its size defines the number
+    ///                             of bytes to be received.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(std::span<std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Receives data from the SPI device into the given DMA buffer. Drivers can use the buffer directly as the DMA
+    /// destination.
+    /// @param buffer               DMA buffer where the received data will be placed. Its size defines the number
+    ///                             of bytes to be received.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(DmaBuffer& buffer, osal::Timeout timeout);
+
+    /// Receives the compile-time known number of bytes from the SPI device without any heap allocation.
+    /// @tparam cSize               Number of bytes to be received.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Array with received data or error code of the operation.
+    /// @note Receiving less than cSize bytes is reported as Error::eHardwareError.
+    template <std::size_t cSize>
+    Result<std::array<std::uint8_t, cSize>> read(osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, cSize> bytes{};
+        auto [actualReadSize, error] = read(bytes.data(), bytes.size(), timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != cSize)
+            return Error::eHardwareError;
+
+        return bytes;
+    }
+
     /// Transmits given vector of bytes to the SPI device and concurrently reads its response.
     /// @param txBytes              Vector of raw bytes to be transmitted.
     /// @param timeout              Maximal time to wait for the bus.
     /// @return Vector with received data or error code of the operation.
     Result<BytesVector> transfer(const BytesVector& txBytes, osal::Timeout timeout);
 
+    /// Transmits given span of bytes to the SPI device and concurrently reads its response.
+    /// @param txBytes              Span of raw bytes to be transmitted.
+    /// @param resource             Memory resource (e.g. hal::BufferPool) used to allocate the output vector.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Vector with received data or error code of the operation.
+    Result<PooledBytesVector>
+    transfer(std::span<const std::uint8_t> txBytes, std::pmr::memory_resource& resource, osal::Timeout timeout);
+
     /// Transmits given memory block of bytes to the SPI device and concurrently reads its response.
     /// @param txBytes              Memory block of raw bytes to be transmitted.
     /// @param rxBytes              Memory block where the received data will be placed.
@@ -157,12 +309,87 @@ public:
     Result<std::size_t>
     transfer(const std::uint8_t* txBytes, std::uint8_t* rxBytes, std::size_t size, osal::Timeout timeout);
 
+    /// Transmits given span of bytes to the SPI device and concurrently reads its response.
+    /// @param txBytes              Span of raw bytes to be transmitted.
+    /// @param rxBytes              Span where the received data will be placed. Must have the same size as txBytes.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t>
+    transfer(std::span<const std::uint8_t> txBytes, std::span<std::uint8_t> rxBytes, osal::Timeout timeout);
+
+    /// Transmits given DMA buffer to the SPI device and concurrently reads its response into another DMA buffer.
+    /// @param txBuffer             DMA buffer to be transmitted.
+    /// @param rxBuffer             DMA buffer where the received data will be placed. Must have the same size
+    ///                             as txBuffer.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> transfer(const DmaBuffer& txBuffer, DmaBuffer& rxBuffer, osal::Timeout timeout);
+
+    /// Transmits given array of bytes to the SPI device and concurrently reads its response without any heap
+    /// allocation.
+    /// @tparam cSize               Number of bytes to be transferred.
+    /// @param txBytes              Array of raw bytes to be transmitted.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Array with received data or error code of the operation.
+    /// @note Receiving less than cSize bytes is reported as Error::eHardwareError.
+    template <std::size_t cSize>
+    Result<std::array<std::uint8_t, cSize>> transfer(const std::array<std::uint8_t, cSize>& txBytes,
+                                                     osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, cSize> rxBytes{};
+        auto [actualReadSize, error] = transfer(txBytes.data(), rxBytes.data(), cSize, timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != cSize)
+            return Error::eHardwareError;
+
+        return rxBytes;
+    }
+
+    /// Performs the scatter-gather transfer described by the given list of segments. Segments are transferred
+    /// in order without copying their buffers, which allows e.g. sending the command header and the payload from
+    /// different memory blocks within one chip select window.
+    /// @param segments             Array of segments to be transferred.
+    /// @param count                Number of segments in the array.
+    /// @param timeout              Maximal time to wait for the whole transfer.
+    /// @return Error code of the operation.
+    std::error_code transfer(const SpiSegment* segments, std::size_t count, osal::Timeout timeout);
+
+    /// Performs the scatter-gather transfer described by the given list of segments.
+    /// @param segments             Span of segments to be transferred.
+    /// @param timeout              Maximal time to wait for the whole transfer.
+    /// @return Error code of the operation.
+    std::error_code transfer(std::span<const SpiSegment> segments, osal::Timeout timeout);
+
+    /// Performs the SPI memory operation.
+    /// @param operation            Memory operation to be performed.
+    /// @param timeout              Maximal time to wait for the whole operation.
+    /// @return Error code of the operation.
+    std::error_code memOp(const SpiMemOp& operation, osal::Timeout timeout);
+
+    /// Starts the continuous streaming of frames performed by the driver (e.g. with the circular DMA). Each frame
+    /// transmits txFrame (or zeros if it is not set) and receives the response into the frame selected by the callback.
+    /// @param ring                 Ring of frames to be used by the driver.
+    /// @param callback             Callback invoked after each frame.
+    /// @return Error code of the operation.
+    /// @note Error::eNotSupported means, that frames have to be pumped by software (see SpiStream).
+    std::error_code startStream(const SpiStreamRing& ring, StreamCallback callback);
+
+    /// Stops the continuous streaming of frames.
+    /// @return Error code of the operation.
+    std::error_code stopStream();
+
 private:
-    /// Checks if the SPI bus is locked.
+    /// Checks if the SPI bus is locked by the calling thread.
     /// @return Flag indicating if the SPI bus is locked.
     /// @retval true                Bus is locked.
     /// @retval false               Bus is not locked.
-    bool isLocked();
+    /// @note This check is lock-free if HAL_THREAD_OWNERSHIP is defined (see BusOwner).
+    [[nodiscard]] bool isLocked() const
+    {
+        return m_owner.isOwner(m_mutex);
+    }
 
     /// Checks if the device is opened.
     /// @return Flag indicating if the device is opened.
@@ -170,6 +397,10 @@ private:
     /// @retval false               Device is not opened.
     [[nodiscard]] bool isOpened() const { return m_opened; }
 
+    /// Returns the identifier of the device selected with the current parameters.
+    /// @return Identifier of the device recorded by the transfer tracer (0 if parameters are not set).
+    [[nodiscard]] std::uint16_t deviceId() const { return m_params ? m_params->deviceId : 0; }
+
     /// Checks the operating state of the driver, which includes checking if it is properly initialized, if the device
     /// is opened and if the SPI bus is locked by this instance of the driver.
     /// @return Error code of the operation.
@@ -214,11 +445,70 @@ private:
     virtual Result<std::size_t>
     drvTransfer(const std::uint8_t* txBytes, std::uint8_t* rxBytes, std::size_t size, osal::Timeout timeout) = 0;
 
+    /// Driver specific implementation of transmitting the DMA buffer.
+    /// @param buffer               DMA buffer to be transmitted.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Error code of the operation.
+    /// @note Default implementation calls drvWrite(). Drivers using DMA should override this method to skip
+    ///       the bounce buffer, because DmaBuffer guarantees the alignment and cache line ownership.
+    virtual std::error_code drvWriteDma(const DmaBuffer& buffer, osal::Timeout timeout);
+
+    /// Driver specific implementation of receiving into the DMA buffer.
+    /// @param buffer               DMA buffer where the received data will be placed.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    /// @note Default implementation calls drvRead().
+    virtual Result<std::size_t> drvReadDma(DmaBuffer& buffer, osal::Timeout timeout);
+
+    /// Driver specific implementation of the full-duplex transfer between the DMA buffers.
+    /// @param txBuffer             DMA buffer to be transmitted.
+    /// @param rxBuffer             DMA buffer where the received data will be placed.
+    /// @param timeout              Maximal time to wait for the bus.
+    /// @return Number of received bytes or error code of the operation.
+    /// @note Default implementation calls drvTransfer().
+    virtual Result<std::size_t> drvTransferDma(const DmaBuffer& txBuffer, DmaBuffer& rxBuffer, osal::Timeout timeout);
+
+    /// Driver specific implementation of the scatter-gather transfer.
+    /// @param segments             Array of segments to be transferred.
+    /// @param count                Number of segments in the array.
+    /// @param timeout              Maximal time to wait for the whole transfer.
+    /// @return Error code of the operation.
+    /// @note Default implementation falls back to the sequence of drvWrite(), drvRead() and drvTransfer() calls.
+    ///       Chip select is not controlled by ISpi, so segments with csChange (except the last one), custom speedHz
+    ///       or bus width other than BusWidth::eSingle are reported as Error::eNotSupported. Drivers, which are able
+    ///       to submit the whole list as one operation (e.g. SPI_IOC_MESSAGE ioctl or chained DMA), should override
+    ///       this method.
+    virtual std::error_code drvTransferList(const SpiSegment* segments, std::size_t count, osal::Timeout timeout);
+
+    /// Driver specific implementation of the SPI memory operation.
+    /// @param operation            Memory operation to be performed.
+    /// @param timeout              Maximal time to wait for the whole operation.
+    /// @return Error code of the operation.
+    /// @note Default implementation translates the operation into the list of segments (one per phase) and calls
+    ///       drvTransferList(). Drivers with the dedicated memory controller (e.g. QSPI with memory-mapped mode)
+    ///       should override this method.
+    virtual std::error_code drvMemOp(const SpiMemOp& operation, osal::Timeout timeout);
+
+    /// Driver specific implementation of starting the continuous streaming of frames.
+    /// @param ring                 Ring of frames to be used by the driver.
+    /// @param callback             Callback invoked after each frame.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvStartStream(const SpiStreamRing& ring, StreamCallback callback);
+
+    /// Driver specific implementation of stopping the continuous streaming of frames.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvStopStream();
+
 private:
     std::uint32_t m_userCount{};
     bool m_opened{};
-    bool m_locked{};
-    osal::Mutex m_mutex{OsalMutexType::eRecursive};
+    BusOwner m_owner;
+    mutable osal::Mutex m_mutex{OsalMutexType::eRecursive};
+    std::shared_ptr<TransferTracer> m_tracer;
+    std::shared_ptr<BusArbiter> m_arbiter;
+    std::optional<SpiParams> m_params;
 };
 
 /// Represents GlobalRegistry of ISpi instances.
@@ -32,49 +32,127 @@
 
 #pragma once
 
+#include "hal/BusArbiter.hpp"
 #include "hal/Error.hpp"
+#include "hal/ScopedBus.hpp"
 #include "hal/gpio/IPinOutput.hpp"
 #include "hal/spi/ISpi.hpp"
+#include "hal/spi/SpiDevice.hpp"
 
 #include <osal/Timeout.hpp>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <system_error>
+#include <utility>
 
 namespace hal::spi {
 
 /// Represents the RAII object to acquire the SPI device in a valid manner. In constructor it automatically
 /// locks the SPI bus, sets the defined parameters and enables the chip select pin. In destructor this process is done
-/// in reverse.
+/// in reverse. Chip select is asserted once for the whole scoped session, so transfers performed within the scope
+/// don't pay for any additional GPIO operations.
 /// @note Release() method should not be called directly, unless necessary. The power of RAII object lays in the fact,
 ///       that Release() method is automatically called, when ScopedSpi is destroyed. This is handy, because in case of
 ///       any error client can just return from the function without worrying about unlocking the SPI.
+/// @note ScopedSpi stores only raw pointers to the SPI driver and the chip select pin (and a copy of the parameters),
+///       so both of them must outlive the guard.
 class ScopedSpi {
 public:
     /// Constructor.
     /// @param spi              Reference to the SPI driver.
     /// @param params           Parameters to be set in the SPI driver.
-    /// @param chipSelect       Reference to the GPIO pin output driver representing the chip select.
-    /// @param timeoutMs        Maximal time to wait for the operation.
+    /// @param chipSelect       Pointer to the GPIO pin output driver representing the chip select (nullptr if chip
+    ///                         select is driven by the SPI driver).
+    /// @param timeout          Maximal time to wait for the operation.
+    /// @param priority         Priority of the bus access.
     /// @note This constructor automatically locks the SPI bus, sets the defined parameters and enables
     ///       the chip select pin.
+    ScopedSpi(ISpi& spi,
+              const SpiParams& params,
+              gpio::IPinOutput* chipSelect,
+              osal::Timeout timeout = osal::Timeout::infinity(),
+              BusPriority priority = BusPriority::eNormal)
+        : m_bus(spi, std::defer_lock)
+        , m_params(params)
+        , m_chipSelect(chipSelect)
+    {
+        static_cast<void>(acquire(timeout, priority));
+    }
+
+    /// Constructor.
+    /// @param spi              Reference to the SPI driver.
+    /// @param params           Parameters to be set in the SPI driver.
+    /// @param chipSelect       Reference to the GPIO pin output driver representing the chip select (nullptr if chip
+    ///                         select is driven by the SPI driver).
+    /// @param timeout          Maximal time to wait for the operation.
+    /// @note This constructor automatically locks the SPI bus, sets the defined parameters and enables
+    ///       the chip select pin. Shared pointers are not stored.
     ScopedSpi(const std::shared_ptr<spi::ISpi>& spi,
               const SpiParams& params,
               const std::shared_ptr<hal::gpio::IPinOutput>& chipSelect,
               osal::Timeout timeout = osal::Timeout::infinity())
-        : m_spi(spi)
-        , m_params(params)
-        , m_chipSelect(chipSelect)
+        : ScopedSpi(*spi, params, chipSelect.get(), timeout)
+    {}
+
+    /// Constructor.
+    /// @param spi              Reference to the SPI driver.
+    /// @param device           Profile of the device to be acquired.
+    /// @param timeout          Maximal time to wait for the operation.
+    /// @param priority         Priority of the bus access.
+    /// @note This constructor automatically locks the SPI bus, sets the parameters from the device profile
+    ///       and enables the chip select pin (if any) respecting the setup delay.
+    ScopedSpi(ISpi& spi,
+              const SpiDevice& device,
+              osal::Timeout timeout = osal::Timeout::infinity(),
+              BusPriority priority = BusPriority::eNormal)
+        : m_bus(spi, std::defer_lock)
+        , m_params(device.params)
+        , m_chipSelect(device.chipSelect.get())
+        , m_setupDelay(device.setupDelay)
+        , m_holdDelay(device.holdDelay)
     {
-        acquire(timeout);
+        static_cast<void>(acquire(timeout, priority));
     }
 
+    /// Constructor.
+    /// @param spi              Reference to the SPI driver.
+    /// @param device           Profile of the device to be acquired.
+    /// @param timeout          Maximal time to wait for the operation.
+    /// @note This constructor automatically locks the SPI bus, sets the parameters from the device profile
+    ///       and enables the chip select pin (if any) respecting the setup delay. Shared pointers are not stored.
+    ScopedSpi(const std::shared_ptr<spi::ISpi>& spi,
+              const SpiDevice& device,
+              osal::Timeout timeout = osal::Timeout::infinity())
+        : ScopedSpi(*spi, device, timeout)
+    {}
+
+    /// Constructor. Doesn't acquire the device, so that it can be acquired later (e.g. with tryAcquire()).
+    /// @param spi              Reference to the SPI driver.
+    /// @param device           Profile of the device to be acquired.
+    ScopedSpi(ISpi& spi, const SpiDevice& device, std::defer_lock_t /*unused*/)
+        : m_bus(spi, std::defer_lock)
+        , m_params(device.params)
+        , m_chipSelect(device.chipSelect.get())
+        , m_setupDelay(device.setupDelay)
+        , m_holdDelay(device.holdDelay)
+    {}
+
     /// Copy constructor.
     /// @note This constructor is deleted, because ScopedSpi is not meant to be copy-constructed.
     ScopedSpi(const ScopedSpi&) = delete;
 
     /// Move constructor.
-    /// @note This constructor is deleted, because ScopedSpi is not meant to be move-constructed.
-    ScopedSpi(ScopedSpi&&) = delete;
+    /// @param other            Object to be moved from.
+    ScopedSpi(ScopedSpi&& other) noexcept
+        : m_bus(std::move(other.m_bus))
+        , m_params(other.m_params)
+        , m_chipSelect(std::exchange(other.m_chipSelect, nullptr))
+        , m_setupDelay(other.m_setupDelay)
+        , m_holdDelay(other.m_holdDelay)
+        , m_selected(std::exchange(other.m_selected, false))
+    {}
 
     /// Copy assignment operator.
     /// @return Reference to self.
@@ -82,9 +160,23 @@ public:
     ScopedSpi& operator=(const ScopedSpi&) = delete;
 
     /// Move assignment operator.
+    /// @param other            Object to be moved from.
     /// @return Reference to self.
-    /// @note This operator is deleted, because ScopedSpi is not meant to be move-assigned.
-    ScopedSpi& operator=(ScopedSpi&&) = delete;
+    /// @note SPI bus held by this object (if any) is released first.
+    ScopedSpi& operator=(ScopedSpi&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            m_bus = std::move(other.m_bus);
+            m_params = other.m_params;
+            m_chipSelect = std::exchange(other.m_chipSelect, nullptr);
+            m_setupDelay = other.m_setupDelay;
+            m_holdDelay = other.m_holdDelay;
+            m_selected = std::exchange(other.m_selected, false);
+        }
+
+        return *this;
+    }
 
     /// Destructor.
     /// @note This destructor automatically disables the chip select pin and unlocks the SPI bus.
@@ -92,22 +184,16 @@ public:
 
     /// Acquires the SPI bus.
     /// @param timeout          Maximal time to wait for the operation.
+    /// @param priority         Priority of the bus access.
     /// @return Error code of the operation.
     /// @note This method automatically locks the SPI bus, sets the defined parameters and enables
     ///       the chip select pin.
-    std::error_code acquire(osal::Timeout timeout)
+    [[nodiscard]] std::error_code acquire(osal::Timeout timeout, BusPriority priority = BusPriority::eNormal)
     {
-        if (isAcquired())
-            return Error::eWrongState;
-
-        if (auto error = m_spi->lock(timeout)) {
-            release();
+        if (auto error = m_bus.acquire(timeout, priority))
             return error;
-        }
 
-        m_locked = true;
-
-        if (auto error = m_spi->setParams(m_params)) {
+        if (auto error = m_bus.bus()->setParams(m_params)) {
             release();
             return error;
         }
@@ -120,6 +206,14 @@ public:
         return Error::eOk;
     }
 
+    /// Acquires the SPI bus only if it is available immediately.
+    /// @param priority         Priority of the bus access.
+    /// @return Error code of the operation.
+    [[nodiscard]] std::error_code tryAcquire(BusPriority priority = BusPriority::eNormal)
+    {
+        return acquire(osal::Timeout(std::chrono::milliseconds(0)), priority);
+    }
+
     /// Releases the SPI bus.
     /// @return Error code of the operation.
     /// @note This method automatically disables the chip select pin and unlocks the SPI bus.
@@ -133,21 +227,14 @@ public:
                 return error;
         }
 
-        if (m_locked) {
-            if (auto error = m_spi->unlock())
-                return error;
-
-            m_locked = false;
-        }
-
-        return Error::eOk;
+        return m_bus.release();
     }
 
     /// Returns the flag indicating if the SPI has been acquired.
     /// @return Flag indicating if the SPI has been acquired.
     /// @retval true            SPI has been acquired.
     /// @retval false           SPI has not been acquired.
-    [[nodiscard]] bool isAcquired() const { return m_locked; }
+    [[nodiscard]] bool isAcquired() const { return m_bus.isAcquired(); }
 
     /// Returns the flag indicating if the SPI chip select is enabled.
     /// @return Flag indicating if the SPI chip select has been enabled.
@@ -157,6 +244,8 @@ public:
 
     /// Enables the chip select manually.
     /// @return Error code of the operation.
+    /// @note If chip select pin is not set, then only the setup delay is applied, because chip select is driven
+    ///       by the SPI driver.
     std::error_code chipSelectEnable()
     {
         if (!isAcquired())
@@ -165,15 +254,20 @@ public:
         if (isChipSelectEnabled())
             return Error::eWrongState;
 
-        if (auto error = m_chipSelect->on())
-            return error;
+        if (m_chipSelect) {
+            if (auto error = m_chipSelect->on())
+                return error;
+        }
 
         m_selected = true;
+        delay(m_setupDelay);
         return Error::eOk;
     }
 
     /// Disables the chip select manually.
     /// @return Error code of the operation.
+    /// @note If chip select pin is not set, then only the hold delay is applied, because chip select is driven
+    ///       by the SPI driver.
     std::error_code chipSelectDisable()
     {
         if (!isAcquired())
@@ -182,19 +276,37 @@ public:
         if (!isChipSelectEnabled())
             return Error::eWrongState;
 
-        if (auto error = m_chipSelect->off())
-            return error;
+        delay(m_holdDelay);
+        if (m_chipSelect) {
+            if (auto error = m_chipSelect->off())
+                return error;
+        }
 
         m_selected = false;
         return Error::eOk;
     }
 
 private:
-    bool m_locked{};
+    /// Waits for the given amount of time.
+    /// @param duration         Time to wait.
+    /// @note Chip select delays are usually in the range of microseconds, which is below the resolution of the OS
+    ///       sleep, so this method busy waits.
+    static void delay(std::chrono::microseconds duration)
+    {
+        if (duration.count() == 0)
+            return;
+
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+
+private:
+    ScopedBus<ISpi> m_bus;
+    SpiParams m_params;
+    gpio::IPinOutput* m_chipSelect{};
+    std::chrono::microseconds m_setupDelay{};
+    std::chrono::microseconds m_holdDelay{};
     bool m_selected{};
-    const std::shared_ptr<ISpi>& m_spi;
-    const SpiParams& m_params;
-    const std::shared_ptr<gpio::IPinOutput>& m_chipSelect;
 };
 
 } // namespace hal::spi
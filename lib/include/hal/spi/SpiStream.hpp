@@ -0,0 +1,191 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/DmaBuffer.hpp"
+#include "hal/SpscQueue.hpp"
+#include "hal/spi/ISpi.hpp"
+#include "hal/spi/ScopedSpi.hpp"
+#include "hal/spi/SpiDevice.hpp"
+#include "hal/types.hpp"
+
+#include <osal/Semaphore.hpp>
+#include <osal/Thread.hpp>
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+
+namespace hal::spi {
+
+/// Represents the statistics of the SPI stream.
+struct SpiStreamStats {
+    std::uint64_t frames{};
+    std::uint64_t overruns{};
+    std::uint64_t errors{};
+};
+
+/// Represents the continuous full-duplex SPI stream (e.g. ADC sampling). Frames are clocked back-to-back into the ring
+/// of DMA-capable buffers and handed over to the consumer through the lock-free queue, so the producer never waits
+/// for the consumer. If the consumer doesn't release frames fast enough, then new frames are clocked into the scratch
+/// buffer and dropped, which is reported as the overrun.
+/// @note Streaming is performed by the driver (see ISpi::startStream()) if it is supported, otherwise frames are
+///       pumped by the dedicated thread. In both cases the thread keeps the bus locked while the stream is running.
+class SpiStream {
+public:
+    /// Constructor.
+    /// @param spi              SPI bus to be used.
+    /// @param device           Profile of the device to be streamed from.
+    /// @param frameSize        Size of the single frame in bytes.
+    /// @param frameCount       Number of frames in the ring.
+    /// @param txFrame          Data transmitted in each frame (padded with zeros to frameSize, empty means zeros).
+    /// @param lockTimeout      Maximal time to wait for the bus each time the stream is started.
+    SpiStream(std::shared_ptr<ISpi> spi,
+              SpiDevice device,
+              std::size_t frameSize,
+              std::size_t frameCount,
+              BytesVector txFrame = {},
+              std::chrono::milliseconds lockTimeout = cInfiniteTimeout);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because SpiStream is not meant to be copy-constructed.
+    SpiStream(const SpiStream&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because SpiStream is not meant to be move-constructed.
+    SpiStream(SpiStream&&) = delete;
+
+    /// Destructor.
+    /// @note This destructor automatically stops the stream.
+    ~SpiStream();
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because SpiStream is not meant to be copy-assigned.
+    SpiStream& operator=(const SpiStream&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because SpiStream is not meant to be move-assigned.
+    SpiStream& operator=(SpiStream&&) = delete;
+
+    /// Starts the stream. Frames left from the previous run, which have not been acquired, are discarded.
+    /// @return Error code of the operation.
+    /// @note Frame acquired before the start remains valid until release() is called.
+    std::error_code start();
+
+    /// Stops the stream. Frames, which were filled but not acquired yet, remain available until the next start().
+    /// @return Error code of the operation.
+    std::error_code stop();
+
+    /// Checks if the stream is running.
+    /// @return Flag indicating if the stream is running.
+    /// @retval true            Stream is running.
+    /// @retval false           Stream is not running.
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /// Acquires the oldest filled frame. Frame remains valid until release() is called.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return Span with the frame data or error code of the operation.
+    /// @note Only one frame can be acquired at a time and only by the single consumer thread.
+    Result<std::span<const std::uint8_t>> acquire(osal::Timeout timeout);
+
+    /// Releases the acquired frame, so that it can be filled again.
+    /// @return Error code of the operation.
+    std::error_code release();
+
+    /// Returns the statistics of the stream.
+    /// @return Statistics of the stream.
+    [[nodiscard]] SpiStreamStats stats() const;
+
+private:
+    /// Main loop of the stream thread.
+    void worker();
+
+    /// Pumps the frames with the blocking transfers until the stream is stopped.
+    /// @param scopedSpi        Acquired SPI bus used to toggle the chip select between frames.
+    /// @param firstFrame       Index of the first frame to be filled.
+    void pump(ScopedSpi& scopedSpi, std::size_t firstFrame);
+
+    /// Publishes the filled frame and selects the next frame to be filled.
+    /// @param filledFrame      Index of the frame, which has just been filled.
+    /// @return Index of the frame to be filled next.
+    std::size_t onFrame(std::size_t filledFrame);
+
+    /// Discards the filled frames and returns all frames (except the acquired one) to the pool of free frames.
+    /// @note Must be called only when the stream thread is not running.
+    void resetFrames();
+
+    /// Returns the next free frame or the scratch frame if there is no free frame.
+    /// @return Index of the next frame to be filled.
+    std::size_t nextFrame();
+
+    /// Returns pointer to the given frame.
+    /// @param index            Index of the frame.
+    /// @return Pointer to the given frame.
+    std::uint8_t* frame(std::size_t index) { return m_buffer.data() + index * m_frameStride; }
+
+private:
+    static constexpr std::size_t m_cNoFrame = static_cast<std::size_t>(-1);
+    static constexpr std::chrono::milliseconds m_cMinErrorBackoff{1};
+    static constexpr std::chrono::milliseconds m_cMaxErrorBackoff{100};
+
+    std::shared_ptr<ISpi> m_spi;
+    SpiDevice m_device;
+    std::size_t m_frameSize;
+    std::size_t m_frameStride;
+    std::size_t m_frameCount;
+    BytesVector m_txFrame;
+    std::chrono::milliseconds m_lockTimeout;
+    DmaBuffer m_buffer;
+    SpscQueue<std::size_t> m_filledFrames;
+    SpscQueue<std::size_t> m_freeFrames;
+    osal::Semaphore m_filledSignal{0};
+    osal::Semaphore m_startSignal{0};
+    osal::Semaphore m_stopSignal{0};
+    std::error_code m_startError;
+    std::size_t m_acquiredFrame{m_cNoFrame};
+    std::atomic<bool> m_running{};
+    std::atomic<std::uint64_t> m_frames{};
+    std::atomic<std::uint64_t> m_overruns{};
+    std::atomic<std::uint64_t> m_errors{};
+    osal::Thread<> m_thread;
+};
+
+} // namespace hal::spi
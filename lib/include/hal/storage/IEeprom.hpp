@@ -34,13 +34,17 @@
 #pragma once
 
 #include "hal/Device.hpp"
+#include "hal/Error.hpp"
 #include "hal/types.hpp"
 
 #include <osal/Timeout.hpp>
 #include <utils/types/Result.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <span>
 #include <system_error>
 
 namespace hal::storage {
@@ -80,6 +84,15 @@ public:
     ///       It is up to the driver to decide if the data will be buffered (queued) or stored immediately.
     std::error_code write(std::uint32_t address, const std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Stores given span of bytes in the current EEPROM device at the given location.
+    /// @param address              Location address, where the data should be stored.
+    /// @param bytes                Span of raw bytes to be stored.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Error code of the operation.
+    /// @note This method will block until all data has been transferred to the driver.
+    ///       It is up to the driver to decide if the data will be buffered (queued) or stored immediately.
+    std::error_code write(std::uint32_t address, std::span<const std::uint8_t> bytes, osal::Timeout timeout);
+
     /// Reads the demanded number of bytes from the current EEPROM device.
     /// @param address              Location address, from where the data should be read.
     /// @param size                 Number of bytes to be read from the current EEPROM device.
@@ -88,6 +101,16 @@ public:
     /// @note Size of the vector after call to this method will indicate the actual number of read bytes.
     Result<BytesVector> read(std::uint32_t address, std::size_t size, osal::Timeout timeout);
 
+    /// Reads the demanded number of bytes from the current EEPROM device.
+    /// @param address              Location address, from where the data should be read.
+    /// @param size                 Number of bytes to be read from the current EEPROM device.
+    /// @param resource             Memory resource (e.g. hal::BufferPool) used to allocate the output vector.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Vector with read data or error code of the operation.
+    /// @note Size of the vector after call to this method will indicate the actual number of read bytes.
+    Result<PooledBytesVector>
+    read(std::uint32_t address, std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout);
+
     /// Reads the demanded number of bytes from the current EEPROM device.
     /// @param address              Location address, from where the data should be read.
     /// @param bytes                Memory block where the read data will be placed by this method.
@@ -99,6 +122,34 @@ public:
     ///       It is also assumed, that output memory block is empty.
     Result<std::size_t> read(std::uint32_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Reads the demanded number of bytes from the current EEPROM device.
+    /// @param address              Location address, from where the data should be read.
+    /// @param bytes                Span where the read data will be placed by this method. Its size defines
+    ///                             the number of bytes to be read.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Number of read bytes or error code of the operation.
+    Result<std::size_t> read(std::uint32_t address, std::span<std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Reads the compile-time known number of bytes from the current EEPROM device without any heap allocation.
+    /// @tparam cSize               Number of bytes to be read.
+    /// @param address              Location address, from where the data should be read.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Array with read data or error code of the operation.
+    /// @note Reading less than cSize bytes is reported as Error::eHardwareError.
+    template <std::size_t cSize>
+    Result<std::array<std::uint8_t, cSize>> read(std::uint32_t address, osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, cSize> bytes{};
+        auto [actualReadSize, error] = read(address, bytes.data(), bytes.size(), timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != cSize)
+            return Error::eHardwareError;
+
+        return bytes;
+    }
+
 private:
     /// Driver specific implementation of storing the memory block of bytes.
     /// @param address              Location address, where the data should be stored.
@@ -32,7 +32,11 @@
 
 #pragma once
 
+#include <osal/Timeout.hpp>
+
+#include <chrono>
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 
 namespace hal {
@@ -40,4 +44,20 @@ namespace hal {
 /// Helper type alias representing vector of bytes.
 using BytesVector = std::vector<std::uint8_t>;
 
+/// Helper type alias representing vector of bytes allocated from the given memory resource (e.g. hal::BufferPool).
+using PooledBytesVector = std::pmr::vector<std::uint8_t>;
+
+/// Represents the infinite timeout stored as the duration.
+/// @note osal::Timeout is a deadline, which starts running when it is created, so components reusing the timeout
+///       for many operations store its duration and create the osal::Timeout right before each operation.
+inline constexpr auto cInfiniteTimeout = std::chrono::milliseconds::max();
+
+/// Creates the timeout, which expires after the given duration from now.
+/// @param duration         Duration of the timeout (cInfiniteTimeout means no expiration).
+/// @return Timeout, which expires after the given duration from now.
+inline osal::Timeout makeTimeout(std::chrono::milliseconds duration)
+{
+    return (duration == cInfiniteTimeout) ? osal::Timeout::infinity() : osal::Timeout(duration);
+}
+
 } // namespace hal
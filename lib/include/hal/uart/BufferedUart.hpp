@@ -0,0 +1,200 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/SpscQueue.hpp"
+#include "hal/uart/IUart.hpp"
+
+#include <osal/Semaphore.hpp>
+#include <osal/Thread.hpp>
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+
+namespace hal::uart {
+
+/// Represents the statistics of the buffered UART.
+struct BufferedUartStats {
+    std::uint64_t rxBytes{};
+    std::uint64_t txBytes{};
+    std::uint64_t rxOverruns{};
+    std::uint64_t errors{};
+};
+
+/// Represents the UART with the lock-free RX and TX rings. Received bytes are collected into the RX ring even if no
+/// thread is waiting in read(), and write() only enqueues the bytes into the TX ring, so the producer never blocks
+/// on the transmission. Bytes received while the RX ring is full are dropped and reported as the overrun.
+/// @note Rings are serviced by the driver (see IUart::startBuffering()) if it is supported, otherwise by the dedicated
+///       RX and TX pump threads.
+/// @note Each ring has a single producer and a single consumer, so read() and write() must not be called concurrently
+///       from more than one thread each.
+class BufferedUart {
+public:
+    /// Constructor.
+    /// @param uart             UART device to be buffered. It must be opened before the buffering is started.
+    /// @param rxSize           Size of the RX ring in bytes (rounded up to the power of 2).
+    /// @param txSize           Size of the TX ring in bytes (rounded up to the power of 2).
+    /// @param pollPeriod       Maximal time for which the pump threads block in the driver.
+    /// @note RX ring should hold at least the data received within one poll period (e.g. ~920 bytes per 10 ms
+    ///       at 921600 baud) plus the worst-case consumer latency.
+    BufferedUart(std::shared_ptr<IUart> uart,
+                 std::size_t rxSize,
+                 std::size_t txSize,
+                 std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(10));
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because BufferedUart is not meant to be copy-constructed.
+    BufferedUart(const BufferedUart&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because BufferedUart is not meant to be move-constructed.
+    BufferedUart(BufferedUart&&) = delete;
+
+    /// Destructor.
+    /// @note This destructor automatically stops the buffering.
+    ~BufferedUart();
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BufferedUart is not meant to be copy-assigned.
+    BufferedUart& operator=(const BufferedUart&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because BufferedUart is not meant to be move-assigned.
+    BufferedUart& operator=(BufferedUart&&) = delete;
+
+    /// Starts servicing the rings.
+    /// @return Error code of the operation.
+    std::error_code start();
+
+    /// Stops servicing the rings. Bytes remaining in the rings are kept, use flush() to transmit the TX ring first.
+    /// @return Error code of the operation.
+    std::error_code stop();
+
+    /// Checks if the rings are serviced.
+    /// @return Flag indicating if the rings are serviced.
+    /// @retval true            Rings are serviced.
+    /// @retval false           Rings are not serviced.
+    [[nodiscard]] bool isRunning() const { return m_running; }
+
+    /// Enqueues the given memory block of bytes for the transmission. This method never blocks.
+    /// @param bytes            Memory block of raw bytes to be transmitted.
+    /// @param size             Size of the memory block to be transmitted.
+    /// @return Error code of the operation.
+    /// @note Memory block is enqueued as a whole or not at all (Error::eNoMemory if the TX ring has not enough space).
+    std::error_code write(const std::uint8_t* bytes, std::size_t size);
+
+    /// Enqueues the given span of bytes for the transmission. This method never blocks.
+    /// @param bytes            Span of raw bytes to be transmitted.
+    /// @return Error code of the operation.
+    std::error_code write(std::span<const std::uint8_t> bytes);
+
+    /// Receives the demanded number of bytes from the RX ring.
+    /// @param bytes            Memory block where the received data will be placed by this method.
+    /// @param size             Number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the data.
+    /// @return Number of received bytes or error code of the operation.
+    /// @note Returned number of bytes is less than size only if the timeout has expired.
+    Result<std::size_t> read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
+
+    /// Receives the demanded number of bytes from the RX ring.
+    /// @param bytes            Span where the received data will be placed by this method. Its size defines
+    ///                         the number of bytes to be received.
+    /// @param timeout          Maximal time to wait for the data.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(std::span<std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Waits until all enqueued bytes have been transmitted. When the TX ring is empty, the driver is drained with
+    /// IUart::drain(), so that also the bytes still being sent by the driver are waited for.
+    /// @param timeout          Maximal time to wait for the TX ring to become empty.
+    /// @return Error code of the operation.
+    /// @note Drivers, which don't support draining, are assumed to be done once they have taken all bytes.
+    std::error_code flush(osal::Timeout timeout);
+
+    /// Returns the number of bytes waiting in the RX ring.
+    /// @return Number of bytes waiting in the RX ring.
+    [[nodiscard]] std::size_t available() const { return m_rxRing.size(); }
+
+    /// Returns the statistics of the buffered UART.
+    /// @return Statistics of the buffered UART.
+    [[nodiscard]] BufferedUartStats stats() const;
+
+private:
+    /// Main loop of the RX pump thread.
+    void rxPump();
+
+    /// Main loop of the TX pump thread.
+    void txPump();
+
+    /// Enqueues the received bytes into the RX ring.
+    /// @param bytes            Received bytes.
+    /// @param size             Number of received bytes.
+    /// @return Number of bytes, which have been enqueued.
+    std::size_t onReceive(const std::uint8_t* bytes, std::size_t size);
+
+    /// Dequeues the bytes to be transmitted from the TX ring.
+    /// @param bytes            Memory block, where the bytes will be placed.
+    /// @param size             Capacity of the memory block.
+    /// @return Number of bytes to be transmitted.
+    std::size_t onTransmit(std::uint8_t* bytes, std::size_t size);
+
+private:
+    static constexpr std::size_t m_cChunkSize = 256;
+
+    std::shared_ptr<IUart> m_uart;
+    std::chrono::milliseconds m_pollPeriod;
+    SpscQueue<std::uint8_t> m_rxRing;
+    SpscQueue<std::uint8_t> m_txRing;
+    osal::Semaphore m_rxSignal{0};
+    osal::Semaphore m_txSignal{0};
+    osal::Semaphore m_txDoneSignal{0};
+    std::atomic<bool> m_running{};
+    std::atomic<bool> m_txBusy{};
+    bool m_interruptDriven{};
+    std::atomic<std::uint64_t> m_rxBytes{};
+    std::atomic<std::uint64_t> m_txBytes{};
+    std::atomic<std::uint64_t> m_rxOverruns{};
+    std::atomic<std::uint64_t> m_errors{};
+    osal::Thread<> m_rxThread;
+    osal::Thread<> m_txThread;
+};
+
+} // namespace hal::uart
@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/types.hpp"
+#include "hal/uart/IUart.hpp"
+
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+
+namespace hal::uart {
+
+/// Represents the framing layer on top of the UART (e.g. NMEA or AT lines, SLIP, COBS or length-prefixed frames).
+/// Data is read from the UART in bulk into the internal buffer and searched for the frame boundaries with memchr()
+/// (which is vectorized by the C library), so there is no per-byte call to the driver and no per-byte allocation.
+/// Frames are returned as views into the internal buffer. SLIP and COBS frames are decoded in place.
+/// @note Returned view remains valid until the next call to any read or reset() method.
+class FrameReader {
+public:
+    /// Constructor.
+    /// @param uart             UART device to be read from.
+    /// @param bufferSize       Size of the internal buffer, which defines the maximal size of a single frame.
+    /// @param chunkSize        Maximal number of bytes requested from the UART in a single read.
+    /// @note Drivers, which wait until the demanded number of bytes is received, add up to one timeout of latency
+    ///       per frame if chunkSize is bigger than the frame, so it should be close to the typical frame size.
+    FrameReader(std::shared_ptr<IUart> uart, std::size_t bufferSize, std::size_t chunkSize = 64);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because FrameReader is not meant to be copy-constructed.
+    FrameReader(const FrameReader&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because FrameReader is not meant to be move-constructed.
+    FrameReader(FrameReader&&) = delete;
+
+    /// Destructor.
+    ~FrameReader() = default;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because FrameReader is not meant to be copy-assigned.
+    FrameReader& operator=(const FrameReader&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because FrameReader is not meant to be move-assigned.
+    FrameReader& operator=(FrameReader&&) = delete;
+
+    /// Reads the data until the given delimiter (e.g. '\n' for NMEA or AT lines).
+    /// @param delimiter        Byte terminating the frame.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return View of the frame (without the delimiter) or error code of the operation.
+    /// @note Frame longer than the internal buffer is dropped and reported as Error::eNoMemory.
+    Result<std::span<const std::uint8_t>> readUntil(std::uint8_t delimiter, osal::Timeout timeout);
+
+    /// Reads the frame preceded by its length.
+    /// @param prefixSize       Size of the length prefix in bytes (1 to 4).
+    /// @param byteOrder        Byte order of the length prefix.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return View of the frame payload or error code of the operation.
+    /// @note Frame longer than the internal buffer is dropped and reported as Error::eNoMemory.
+    Result<std::span<const std::uint8_t>>
+    readLengthPrefixed(std::size_t prefixSize, std::endian byteOrder, osal::Timeout timeout);
+
+    /// Reads the COBS encoded frame terminated by the zero byte.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return View of the decoded frame or error code of the operation.
+    /// @note Empty frames are skipped. Malformed frame is dropped and reported as Error::eFrameError.
+    Result<std::span<const std::uint8_t>> readCobs(osal::Timeout timeout);
+
+    /// Reads the SLIP (RFC 1055) encoded frame.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return View of the decoded frame or error code of the operation.
+    /// @note Empty frames are skipped. Malformed frame is dropped and reported as Error::eFrameError.
+    Result<std::span<const std::uint8_t>> readSlip(osal::Timeout timeout);
+
+    /// Drops all buffered data (e.g. to resynchronize after an error).
+    void reset();
+
+    /// Returns the number of buffered bytes, which don't belong to any returned frame yet.
+    /// @return Number of buffered bytes.
+    [[nodiscard]] std::size_t buffered() const { return m_end - m_begin; }
+
+private:
+    /// Reads the data until the given delimiter.
+    /// @param delimiter        Byte terminating the frame.
+    /// @param timeout          Maximal time to wait for the frame.
+    /// @return View of the frame (without the delimiter) or error code of the operation.
+    Result<std::span<std::uint8_t>> next(std::uint8_t delimiter, osal::Timeout timeout);
+
+    /// Ensures, that at least the given number of bytes is buffered.
+    /// @param size             Demanded number of buffered bytes.
+    /// @param timeout          Maximal time to wait for the data.
+    /// @return Error code of the operation.
+    std::error_code require(std::size_t size, osal::Timeout timeout);
+
+    /// Reads the next chunk of data from the UART into the internal buffer.
+    /// @param timeout          Maximal time to wait for the data.
+    /// @return Error code of the operation.
+    std::error_code fill(osal::Timeout timeout);
+
+    /// Decodes the COBS frame in place.
+    /// @param bytes            Encoded frame (without the zero delimiter).
+    /// @param size             Size of the encoded frame.
+    /// @return Size of the decoded frame or error code of the operation.
+    static Result<std::size_t> decodeCobs(std::uint8_t* bytes, std::size_t size);
+
+    /// Decodes the SLIP frame in place.
+    /// @param bytes            Encoded frame (without the END delimiter).
+    /// @param size             Size of the encoded frame.
+    /// @return Size of the decoded frame or error code of the operation.
+    static Result<std::size_t> decodeSlip(std::uint8_t* bytes, std::size_t size);
+
+private:
+    std::shared_ptr<IUart> m_uart;
+    BytesVector m_buffer;
+    std::size_t m_chunkSize;
+    std::size_t m_begin{};
+    std::size_t m_end{};
+    std::size_t m_scanned{};
+    std::uint8_t m_delimiter{};
+};
+
+} // namespace hal::uart
@@ -34,38 +34,103 @@
 #pragma once
 
 #include "hal/Device.hpp"
+#include "hal/Error.hpp"
 #include "hal/types.hpp"
 
 #include <osal/Timeout.hpp>
 #include <utils/registry/GlobalRegistry.hpp>
 #include <utils/types/Result.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
 #include <system_error>
 
 namespace hal::uart {
 
 /// Represents the baud rate (speed) used in the UART transmission.
-enum class Baudrate {
-    e1200 = 1200,     // NOLINT
-    e2400 = 2400,     // NOLINT
-    e4800 = 4800,     // NOLINT
-    e9600 = 9600,     // NOLINT
-    e19200 = 19200,   // NOLINT
-    e38400 = 38400,   // NOLINT
-    e57600 = 57600,   // NOLINT
-    e115200 = 115200, // NOLINT
-    e230400 = 230400, // NOLINT
-    e460800 = 460800, // NOLINT
-    e921600 = 921600  // NOLINT
+/// @note Any other baud rate supported by the driver can be used as Baudrate{rate}.
+enum class Baudrate : std::uint32_t {
+    e1200 = 1200,       // NOLINT
+    e2400 = 2400,       // NOLINT
+    e4800 = 4800,       // NOLINT
+    e9600 = 9600,       // NOLINT
+    e19200 = 19200,     // NOLINT
+    e38400 = 38400,     // NOLINT
+    e57600 = 57600,     // NOLINT
+    e115200 = 115200,   // NOLINT
+    e230400 = 230400,   // NOLINT
+    e460800 = 460800,   // NOLINT
+    e500000 = 500000,   // NOLINT
+    e576000 = 576000,   // NOLINT
+    e921600 = 921600,   // NOLINT
+    e1000000 = 1000000, // NOLINT
+    e1500000 = 1500000, // NOLINT
+    e2000000 = 2000000, // NOLINT
+    e3000000 = 3000000, // NOLINT
+    e4000000 = 4000000  // NOLINT
 };
 
 /// Represents possible UART configurations in traditional form (<data bits><parity><stop bits>).
 enum class Mode {
-    e8n1 // NOLINT
+    e8n1, // NOLINT
+    e8e1, // NOLINT
+    e8o1, // NOLINT
+    e8n2, // NOLINT
+    e8e2, // NOLINT
+    e8o2, // NOLINT
+    e7n1, // NOLINT
+    e7e1, // NOLINT
+    e7o1, // NOLINT
+    e7n2, // NOLINT
+    e7e2, // NOLINT
+    e7o2, // NOLINT
+    e6n1, // NOLINT
+    e5n1  // NOLINT
 };
 
+/// Represents the parity used in the UART transmission.
+enum class Parity {
+    eNone,
+    eEven,
+    eOdd
+};
+
+/// Represents the UART mode split into its components.
+struct FrameFormat {
+    std::uint8_t dataBits{};
+    Parity parity{};
+    std::uint8_t stopBits{};
+};
+
+/// Splits the given mode into its components.
+/// @param mode                 Mode to be split.
+/// @return Components of the given mode.
+constexpr FrameFormat frameFormat(Mode mode)
+{
+    switch (mode) {
+        case Mode::e8n1: return {8, Parity::eNone, 1};  // NOLINT
+        case Mode::e8e1: return {8, Parity::eEven, 1};  // NOLINT
+        case Mode::e8o1: return {8, Parity::eOdd, 1};   // NOLINT
+        case Mode::e8n2: return {8, Parity::eNone, 2};  // NOLINT
+        case Mode::e8e2: return {8, Parity::eEven, 2};  // NOLINT
+        case Mode::e8o2: return {8, Parity::eOdd, 2};   // NOLINT
+        case Mode::e7n1: return {7, Parity::eNone, 1};  // NOLINT
+        case Mode::e7e1: return {7, Parity::eEven, 1};  // NOLINT
+        case Mode::e7o1: return {7, Parity::eOdd, 1};   // NOLINT
+        case Mode::e7n2: return {7, Parity::eNone, 2};  // NOLINT
+        case Mode::e7e2: return {7, Parity::eEven, 2};  // NOLINT
+        case Mode::e7o2: return {7, Parity::eOdd, 2};   // NOLINT
+        case Mode::e6n1: return {6, Parity::eNone, 1};  // NOLINT
+        case Mode::e5n1: return {5, Parity::eNone, 1};  // NOLINT
+    }
+
+    return {};
+}
+
 /// Represents the flow control selected to be used in the UART transmission.
 enum class FlowControl {
     eNone,
@@ -73,6 +138,16 @@ enum class FlowControl {
     eXonXoff
 };
 
+/// Represents the callback invoked by the driver with the received bytes. It returns the number of bytes, which have
+/// been accepted (the rest is dropped).
+/// @note Callback may be invoked from the interrupt context.
+using RxCallback = std::function<std::size_t(const std::uint8_t*, std::size_t)>;
+
+/// Represents the callback invoked by the driver, when it is ready to transmit. It fills the given memory block with
+/// the bytes to be transmitted and returns their number (0 if there is nothing to transmit).
+/// @note Callback may be invoked from the interrupt context.
+using TxCallback = std::function<std::size_t(std::uint8_t*, std::size_t)>;
+
 /// Represents a single UART device. All operations will be limited to the given instance of this class.
 class IUart : public Device {
 public:
@@ -121,18 +196,27 @@ public:
     /// Sets the given baudrate to be used in the UART transmission.
     /// @param baudrate             Baudrate to be used.
     /// @return Error code of the operation.
+    /// @note If the device is opened, then the pending data is drained first (see IUart::drain()).
     std::error_code setBaudrate(Baudrate baudrate);
 
     /// Sets the mode (data bits, parity, stop bits) to be used in the UART transmission.
     /// @param mode                 Mode to be used.
     /// @return Error code of the operation.
+    /// @note If the device is opened, then the pending data is drained first (see IUart::drain()).
     std::error_code setMode(Mode mode);
 
     /// Sets the given flow control to be used in the UART transmission.
     /// @param flowControl          Flow control to be used.
     /// @return Error code of the operation.
+    /// @note If the device is opened, then the pending data is drained first (see IUart::drain()).
     std::error_code setFlowControl(FlowControl flowControl);
 
+    /// Waits until all data written so far has been physically transmitted.
+    /// @return Error code of the operation.
+    /// @note Drivers, which don't support draining, can be reconfigured only when closed. In that case the setters
+    ///       called on the opened device return Error::eDeviceOpened.
+    std::error_code drain();
+
     /// Transmits the given vector of bytes using the current UART instance.
     /// @param bytes                Vector of raw bytes to be transmitted.
     /// @return Error code of the operation.
@@ -148,6 +232,13 @@ public:
     ///       It is up to the driver to decide if the data will be buffered (queued) or transmitted immediately.
     std::error_code write(const std::uint8_t* bytes, std::size_t size);
 
+    /// Transmits the given span of bytes using the current UART instance.
+    /// @param bytes                Span of raw bytes to be transmitted.
+    /// @return Error code of the operation.
+    /// @note This method will block until all data has been transferred to the driver.
+    ///       It is up to the driver to decide if the data will be buffered (queued) or transmitted immediately.
+    std::error_code write(std::span<const std::uint8_t> bytes);
+
     /// Receives the demanded number of bytes from the current UART instance.
     /// @param size                 Number of bytes to be received from the current UART instance.
     /// @param timeout              Maximal time to wait for the data.
@@ -155,6 +246,14 @@ public:
     /// @note Size of the vector after call to this method will indicate the actual number of received bytes.
     Result<BytesVector> read(std::size_t size, osal::Timeout timeout);
 
+    /// Receives the demanded number of bytes from the current UART instance.
+    /// @param size                 Number of bytes to be received from the current UART instance.
+    /// @param resource             Memory resource (e.g. hal::BufferPool) used to allocate the output vector.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Vector with received data or error code of the operation.
+    /// @note Size of the vector after call to this method will indicate the actual number of received bytes.
+    Result<PooledBytesVector> read(std::size_t size, std::pmr::memory_resource& resource, osal::Timeout timeout);
+
     /// Receives the demanded number of bytes from the current UART instance.
     /// @param bytes                Memory block where the received data will be placed by this method.
     /// @param size                 Number of bytes to be received from the current UART instance.
@@ -165,6 +264,55 @@ public:
     ///       It is also assumed, that output memory block is empty.
     Result<std::size_t> read(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout);
 
+    /// Receives the demanded number of bytes from the current UART instance.
+    /// @param bytes                Span where the received data will be placed by this method. Its size defines
+    ///                             the number of bytes to be received.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Number of received bytes or error code of the operation.
+    Result<std::size_t> read(std::span<std::uint8_t> bytes, osal::Timeout timeout);
+
+    /// Receives the compile-time known number of bytes from the current UART instance without any heap allocation.
+    /// @tparam cSize               Number of bytes to be received.
+    /// @param timeout              Maximal time to wait for the data.
+    /// @return Array with received data or error code of the operation.
+    /// @note Receiving less than cSize bytes within the given timeout is reported as Error::eTimeout.
+    template <std::size_t cSize>
+    Result<std::array<std::uint8_t, cSize>> read(osal::Timeout timeout)
+    {
+        std::array<std::uint8_t, cSize> bytes{};
+        auto [actualReadSize, error] = read(bytes.data(), bytes.size(), timeout);
+        if (error)
+            return error;
+
+        if (*actualReadSize != cSize)
+            return Error::eTimeout;
+
+        return bytes;
+    }
+
+    /// Starts the interrupt driven servicing of the transmission. After a successful call to this method the driver
+    /// passes every received byte to the RX callback and pulls the bytes to be transmitted from the TX callback,
+    /// without any thread being blocked in read() or write().
+    /// @param rxCallback           Callback receiving the incoming bytes.
+    /// @param txCallback           Callback providing the outgoing bytes.
+    /// @return Error code of the operation.
+    /// @note Error::eNotSupported means, that the driver has no interrupt hook and the caller has to pump the data
+    ///       with read() and write().
+    std::error_code startBuffering(RxCallback rxCallback, TxCallback txCallback);
+
+    /// Stops the interrupt driven servicing of the transmission.
+    /// @return Error code of the operation.
+    std::error_code stopBuffering();
+
+    /// Notifies the driver, that the TX callback has new bytes to be transmitted (e.g. to enable the TX interrupt).
+    /// @return Error code of the operation.
+    std::error_code notifyTxPending();
+
+private:
+    /// Prepares the device for the change of the settings.
+    /// @return Error code of the operation.
+    std::error_code prepareReconfiguration();
+
 private:
     /// Device specific implementation of the opening transmission channel.
     /// @return Error code of the operation.
@@ -202,6 +350,29 @@ private:
     /// @return Number of received bytes or error code of the operation.
     virtual Result<std::size_t> drvRead(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) = 0;
 
+    /// Device specific implementation of waiting until all written data has been physically transmitted.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported. Driver implementing this method must be able
+    ///       to apply the new settings while opened.
+    virtual std::error_code drvDrain();
+
+    /// Device specific implementation of starting the interrupt driven servicing of the transmission.
+    /// @param rxCallback           Callback receiving the incoming bytes.
+    /// @param txCallback           Callback providing the outgoing bytes.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvStartBuffering(RxCallback rxCallback, TxCallback txCallback);
+
+    /// Device specific implementation of stopping the interrupt driven servicing of the transmission.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvStopBuffering();
+
+    /// Device specific implementation of notifying about the new bytes to be transmitted.
+    /// @return Error code of the operation.
+    /// @note Default implementation returns Error::eNotSupported.
+    virtual std::error_code drvNotifyTxPending();
+
 private:
     bool m_opened{};
 };
@@ -0,0 +1,330 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/i2c/LinuxI2c.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace hal::i2c {
+namespace {
+
+/// Converts the errno value reported by the i2c-dev driver into the error code.
+/// @param errnoValue       Value of errno.
+/// @return Error code corresponding to the given errno value.
+std::error_code toError(int errnoValue)
+{
+    switch (errnoValue) {
+        case ENXIO:
+        case EREMOTEIO: return Error::eNack;
+        case EAGAIN: return Error::eArbitrationLost;
+        case ETIMEDOUT: return Error::eTimeout;
+        case EINVAL: return Error::eInvalidArgument;
+        case EOPNOTSUPP: return Error::eNotSupported;
+        case ENOMEM: return Error::eNoMemory;
+        default: return Error::eHardwareError;
+    }
+}
+
+} // namespace
+
+LinuxI2c::LinuxI2c(std::string devicePath)
+    : m_devicePath(std::move(devicePath))
+{}
+
+LinuxI2c::~LinuxI2c()
+{
+    if (m_fd != m_cInvalidFd)
+        ::close(m_fd);
+}
+
+std::error_code LinuxI2c::drvSetParams(I2cParams params)
+{
+    if (params.addressingMode == AddressingMode::e10bit && (m_functionality & I2C_FUNC_10BIT_ADDR) == 0) {
+        I2cLogger::error("Failed to set params: 10-bit addressing is not supported by '{}'", m_devicePath);
+        return Error::eNotSupported;
+    }
+
+    m_addressingMode = params.addressingMode;
+    return Error::eOk;
+}
+
+std::error_code LinuxI2c::drvOpen()
+{
+    m_fd = ::open(m_devicePath.c_str(), O_RDWR | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (m_fd == m_cInvalidFd) {
+        I2cLogger::error("Failed to open '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    if (::ioctl(m_fd, I2C_FUNCS, &m_functionality) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        I2cLogger::error("Failed to read functionality of '{}': {}", m_devicePath, std::strerror(errno));
+        ::close(m_fd);
+        m_fd = m_cInvalidFd;
+        return Error::eHardwareError;
+    }
+
+    m_timeoutUnits = 0;
+    m_slaveAddress = m_cInvalidAddress;
+    I2cLogger::debug("Opened '{}' (functionality={:#x})", m_devicePath, m_functionality);
+    return Error::eOk;
+}
+
+std::error_code LinuxI2c::drvClose()
+{
+    if (::close(m_fd) != 0) {
+        I2cLogger::error("Failed to close '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    m_fd = m_cInvalidFd;
+    return Error::eOk;
+}
+
+std::error_code LinuxI2c::drvWrite(std::uint16_t address,
+                                   const std::uint8_t* bytes,
+                                   std::size_t size,
+                                   bool stop,
+                                   osal::Timeout timeout)
+{
+    if (!stop) {
+        I2cLogger::error("Failed to write: i2c-dev always generates the stop condition, use transfer() instead");
+        return Error::eNotSupported;
+    }
+
+    I2cMessage message{address, bytes, nullptr, size};
+    return drvTransfer(&message, 1, timeout);
+}
+
+Result<std::size_t>
+LinuxI2c::drvRead(std::uint16_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
+{
+    I2cMessage message{address, nullptr, bytes, size};
+    if (auto error = drvTransfer(&message, 1, timeout))
+        return error;
+
+    return size;
+}
+
+std::error_code LinuxI2c::drvTransfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout)
+{
+    if (auto error = setTimeout(timeout))
+        return error;
+
+    if ((m_functionality & I2C_FUNC_I2C) == 0)
+        return smbusTransfer(messages, count);
+
+    if (count > I2C_RDWR_IOCTL_MAX_MSGS) {
+        I2cLogger::error("Failed to transfer: count={} exceeds i2c-dev limit={}", count, I2C_RDWR_IOCTL_MAX_MSGS);
+        return Error::eInvalidArgument;
+    }
+
+    std::array<i2c_msg, I2C_RDWR_IOCTL_MAX_MSGS> i2cMessages{};
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& message = messages[i];
+        auto& i2cMessage = i2cMessages[i];
+
+        if (message.size > UINT16_MAX) {
+            I2cLogger::error("Failed to transfer: message {} has size={} exceeding i2c-dev limit", i, message.size);
+            return Error::eInvalidArgument;
+        }
+
+        if (!verifyAddress(m_addressingMode, message.address)) {
+            I2cLogger::error("Failed to transfer: message {} has invalid address={:#x}", i, message.address);
+            return Error::eInvalidArgument;
+        }
+
+        i2cMessage.addr = message.address;
+        i2cMessage.len = std::uint16_t(message.size);
+        if (m_addressingMode == AddressingMode::e10bit)
+            i2cMessage.flags |= I2C_M_TEN;
+
+        if (message.rxBytes != nullptr) {
+            i2cMessage.flags |= I2C_M_RD;
+            i2cMessage.buf = message.rxBytes;
+        }
+        else {
+            // i2c-dev doesn't modify the buffers of write messages.
+            i2cMessage.buf = const_cast<std::uint8_t*>(message.txBytes); // NOLINT
+        }
+    }
+
+    i2c_rdwr_ioctl_data data{i2cMessages.data(), std::uint32_t(count)};
+    if (::ioctl(m_fd, I2C_RDWR, &data) < 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        auto error = toError(errno);
+        I2cLogger::debug("I2C_RDWR failed: address={:#x}, count={}, err={}",
+                         messages[0].address,
+                         count,
+                         error.message());
+        return error;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code LinuxI2c::drvProbe(std::uint16_t address, osal::Timeout timeout)
+{
+    if (auto error = setTimeout(timeout))
+        return error;
+
+    if (m_addressingMode == AddressingMode::e7bit && (m_functionality & I2C_FUNC_SMBUS_QUICK) != 0)
+        return smbusAccess(address, I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK, nullptr);
+
+    std::uint8_t byte{};
+    I2cMessage message{address, nullptr, &byte, sizeof(byte)};
+    return drvTransfer(&message, 1, timeout);
+}
+
+std::error_code LinuxI2c::setTimeout(osal::Timeout timeout)
+{
+    auto timeoutMs = std::clamp<std::uint32_t>(osal::durationMs(timeout), m_cTimeoutUnitMs, m_cMaxTimeoutMs);
+    auto timeoutUnits = (timeoutMs + m_cTimeoutUnitMs - 1) / m_cTimeoutUnitMs;
+    if (timeoutUnits == m_timeoutUnits)
+        return Error::eOk;
+
+    if (::ioctl(m_fd, I2C_TIMEOUT, static_cast<unsigned long>(timeoutUnits)) != 0) { // NOLINT
+        I2cLogger::error("Failed to set timeout={} ms: {}", timeoutMs, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    m_timeoutUnits = timeoutUnits;
+    return Error::eOk;
+}
+
+std::error_code LinuxI2c::smbusTransfer(const I2cMessage* messages, std::size_t count)
+{
+    i2c_smbus_data data{};
+    const auto& first = messages[0];
+
+    if (count == 1 && first.txBytes != nullptr) {
+        switch (first.size) {
+            case 0: return smbusAccess(first.address, I2C_SMBUS_WRITE, 0, I2C_SMBUS_QUICK, nullptr);
+            case 1: return smbusAccess(first.address, I2C_SMBUS_WRITE, first.txBytes[0], I2C_SMBUS_BYTE, nullptr);
+            case 2:
+                data.byte = first.txBytes[1];
+                return smbusAccess(first.address, I2C_SMBUS_WRITE, first.txBytes[0], I2C_SMBUS_BYTE_DATA, &data);
+            default: break;
+        }
+
+        if (first.size <= I2C_SMBUS_BLOCK_MAX + 1 && (m_functionality & I2C_FUNC_SMBUS_WRITE_I2C_BLOCK) != 0) {
+            data.block[0] = std::uint8_t(first.size - 1);
+            std::copy_n(first.txBytes + 1, first.size - 1, &data.block[1]);
+            return smbusAccess(first.address, I2C_SMBUS_WRITE, first.txBytes[0], I2C_SMBUS_I2C_BLOCK_DATA, &data);
+        }
+    }
+    else if (count == 1 && first.size == 1) {
+        if (auto error = smbusAccess(first.address, I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &data))
+            return error;
+
+        first.rxBytes[0] = data.byte;
+        return Error::eOk;
+    }
+    else if (count == 2 && first.txBytes != nullptr && first.size == 1 && messages[1].rxBytes != nullptr
+             && messages[1].address == first.address) {
+        const auto& second = messages[1];
+        auto command = first.txBytes[0];
+
+        switch (second.size) {
+            case 1:
+                if (auto error = smbusAccess(first.address, I2C_SMBUS_READ, command, I2C_SMBUS_BYTE_DATA, &data))
+                    return error;
+
+                second.rxBytes[0] = data.byte;
+                return Error::eOk;
+            case 2:
+                if (auto error = smbusAccess(first.address, I2C_SMBUS_READ, command, I2C_SMBUS_WORD_DATA, &data))
+                    return error;
+
+                // SMBus words are transmitted LSB first.
+                second.rxBytes[0] = std::uint8_t(data.word);
+                second.rxBytes[1] = std::uint8_t(data.word >> 8); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+                return Error::eOk;
+            default: break;
+        }
+
+        if (second.size <= I2C_SMBUS_BLOCK_MAX && (m_functionality & I2C_FUNC_SMBUS_READ_I2C_BLOCK) != 0) {
+            data.block[0] = std::uint8_t(second.size);
+            if (auto error = smbusAccess(first.address, I2C_SMBUS_READ, command, I2C_SMBUS_I2C_BLOCK_DATA, &data))
+                return error;
+
+            std::copy_n(&data.block[1], second.size, second.rxBytes);
+            return Error::eOk;
+        }
+    }
+
+    I2cLogger::error("Failed to transfer: transaction cannot be expressed with SMBus commands");
+    return Error::eNotSupported;
+}
+
+std::error_code LinuxI2c::smbusAccess(std::uint16_t address,
+                                      std::uint8_t readWrite,
+                                      std::uint8_t command,
+                                      std::uint32_t protocol,
+                                      void* data)
+{
+    if (m_addressingMode == AddressingMode::e10bit) {
+        I2cLogger::error("Failed to transfer: 10-bit address={:#x} is not supported by SMBus", address);
+        return Error::eNotSupported;
+    }
+
+    if (address != m_slaveAddress) {
+        if (::ioctl(m_fd, I2C_SLAVE, static_cast<unsigned long>(address)) != 0) { // NOLINT
+            I2cLogger::error("Failed to set slave address={:#x}: {}", address, std::strerror(errno));
+            return toError(errno);
+        }
+
+        m_slaveAddress = address;
+    }
+
+    i2c_smbus_ioctl_data args{readWrite, command, protocol, static_cast<i2c_smbus_data*>(data)};
+    if (::ioctl(m_fd, I2C_SMBUS, &args) < 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        auto error = toError(errno);
+        I2cLogger::debug("I2C_SMBUS failed: address={:#x}, protocol={}, err={}", address, protocol, error.message());
+        return error;
+    }
+
+    return Error::eOk;
+}
+
+} // namespace hal::i2c
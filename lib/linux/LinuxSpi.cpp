@@ -0,0 +1,314 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/spi/LinuxSpi.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+namespace hal::spi {
+namespace {
+
+/// Path to the spidev module parameter holding the maximal size of the single SPI_IOC_MESSAGE.
+constexpr const char* cBufferSizePath = "/sys/module/spidev/parameters/bufsiz";
+
+/// Alignment of the transfers in the spidev bounce buffers. spidev rounds the length of each transfer up to
+/// ARCH_KMALLOC_MINALIGN before checking the sum against bufsiz and fails the whole message with EMSGSIZE if it
+/// doesn't fit. The kernel doesn't expose this value to the user space, so the largest one used by the supported
+/// architectures (128 bytes on arm64 and some 32-bit ARM configurations) is assumed. Overestimating it only
+/// splits the transfers into more messages, while underestimating it makes the ioctl fail.
+constexpr std::size_t cTransferAlignment = 128;
+
+/// Maximal number of transfers, which can be encoded in the SPI_IOC_MESSAGE ioctl number.
+constexpr std::size_t cMaxTransfersPerMessage = ((1U << _IOC_SIZEBITS) - 1) / sizeof(spi_ioc_transfer);
+
+/// Returns the SPI_IOC_MESSAGE ioctl number for the given number of transfers.
+/// @param count            Number of transfers in the message.
+/// @return SPI_IOC_MESSAGE ioctl number for the given number of transfers.
+/// @note SPI_IOC_MESSAGE macro cannot be used with the runtime count in C++.
+unsigned long messageRequest(std::size_t count) // NOLINT(google-runtime-int)
+{
+    return _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, count * sizeof(spi_ioc_transfer));
+}
+
+/// Reads the spidev buffer size from sysfs.
+/// @param defaultSize      Size to be returned if the parameter cannot be read.
+/// @return Size of the spidev buffer.
+std::size_t readBufferSize(std::size_t defaultSize)
+{
+    constexpr std::size_t cMaxDigits = 16;
+
+    int fd = ::open(cBufferSizePath, O_RDONLY | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fd < 0)
+        return defaultSize;
+
+    std::array<char, cMaxDigits> buffer{};
+    auto readSize = ::read(fd, buffer.data(), buffer.size());
+    ::close(fd);
+    if (readSize <= 0)
+        return defaultSize;
+
+    std::size_t size{};
+    auto [end, error] = std::from_chars(buffer.data(), buffer.data() + readSize, size);
+    if (error != std::errc() || size == 0)
+        return defaultSize;
+
+    return size;
+}
+
+/// Converts the maximal bus widths into the spidev mode flags.
+/// @param txWidth          Maximal bus width used to transmit the data.
+/// @param rxWidth          Maximal bus width used to receive the data.
+/// @return Spidev mode flags corresponding to the given bus widths.
+std::uint32_t toModeFlags(BusWidth txWidth, BusWidth rxWidth)
+{
+    std::uint32_t flags{};
+
+    switch (txWidth) {
+        case BusWidth::eSingle: break;
+        case BusWidth::eDual: flags |= SPI_TX_DUAL; break;
+        case BusWidth::eQuad: flags |= SPI_TX_QUAD; break;
+        case BusWidth::eOctal: flags |= SPI_TX_OCTAL; break;
+    }
+
+    switch (rxWidth) {
+        case BusWidth::eSingle: break;
+        case BusWidth::eDual: flags |= SPI_RX_DUAL; break;
+        case BusWidth::eQuad: flags |= SPI_RX_QUAD; break;
+        case BusWidth::eOctal: flags |= SPI_RX_OCTAL; break;
+    }
+
+    return flags;
+}
+
+/// Converts the errno value reported by the spidev driver into the error code.
+/// @param errnoValue       Value of errno.
+/// @return Error code corresponding to the given errno value.
+std::error_code toError(int errnoValue)
+{
+    switch (errnoValue) {
+        case EINVAL:
+        case EMSGSIZE: return Error::eInvalidArgument;
+        case ENOMEM: return Error::eNoMemory;
+        case EOPNOTSUPP: return Error::eNotSupported;
+        case ETIMEDOUT: return Error::eTimeout;
+        default: return Error::eHardwareError;
+    }
+}
+
+} // namespace
+
+LinuxSpi::LinuxSpi(std::string devicePath)
+    : m_devicePath(std::move(devicePath))
+{}
+
+LinuxSpi::~LinuxSpi()
+{
+    if (m_fd != m_cInvalidFd)
+        ::close(m_fd);
+}
+
+std::error_code LinuxSpi::drvOpen()
+{
+    m_fd = ::open(m_devicePath.c_str(), O_RDWR | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (m_fd == m_cInvalidFd) {
+        SpiLogger::error("Failed to open '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    m_bufferSize = readBufferSize(m_cDefaultBufferSize);
+    SpiLogger::debug("Opened '{}' (bufsiz={})", m_devicePath, m_bufferSize);
+    return Error::eOk;
+}
+
+std::error_code LinuxSpi::drvClose()
+{
+    if (::close(m_fd) != 0) {
+        SpiLogger::error("Failed to close '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    m_fd = m_cInvalidFd;
+    return Error::eOk;
+}
+
+std::error_code LinuxSpi::drvSetParams(SpiParams params)
+{
+    constexpr std::uint8_t cDefaultWordLength = 8;
+
+    std::uint32_t mode{};
+    switch (params.clockMode) {
+        case Mode::eMode0: mode = SPI_MODE_0; break;
+        case Mode::eMode1: mode = SPI_MODE_1; break;
+        case Mode::eMode2: mode = SPI_MODE_2; break;
+        case Mode::eMode3: mode = SPI_MODE_3; break;
+    }
+
+    mode |= toModeFlags(params.txWidth, params.rxWidth);
+    std::uint8_t wordLength = (params.wordLength != 0) ? params.wordLength : cDefaultWordLength;
+    std::uint32_t frequencyHz = params.frequencyHz;
+
+    if (::ioctl(m_fd, SPI_IOC_WR_MODE32, &mode) != 0                   // NOLINT(cppcoreguidelines-pro-type-vararg)
+        || ::ioctl(m_fd, SPI_IOC_WR_BITS_PER_WORD, &wordLength) != 0 // NOLINT(cppcoreguidelines-pro-type-vararg)
+        || ::ioctl(m_fd, SPI_IOC_WR_MAX_SPEED_HZ, &frequencyHz) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        auto error = toError(errno);
+        SpiLogger::error("Failed to set params: {}", std::strerror(errno));
+        return error;
+    }
+
+    return Error::eOk;
+}
+
+std::error_code LinuxSpi::drvWrite(const std::uint8_t* bytes, std::size_t size, osal::Timeout /*timeout*/)
+{
+    append(bytes, nullptr, size, 0, false);
+    return submit();
+}
+
+Result<std::size_t> LinuxSpi::drvRead(std::uint8_t* bytes, std::size_t size, osal::Timeout /*timeout*/)
+{
+    append(nullptr, bytes, size, 0, false);
+    if (auto error = submit())
+        return error;
+
+    return size;
+}
+
+Result<std::size_t> LinuxSpi::drvTransfer(const std::uint8_t* txBytes,
+                                          std::uint8_t* rxBytes,
+                                          std::size_t size,
+                                          osal::Timeout /*timeout*/)
+{
+    append(txBytes, rxBytes, size, 0, false);
+    if (auto error = submit())
+        return error;
+
+    return size;
+}
+
+std::error_code LinuxSpi::drvTransferList(const SpiSegment* segments, std::size_t count, osal::Timeout /*timeout*/)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& segment = segments[i];
+        append(segment.txBytes,
+               segment.rxBytes,
+               segment.size,
+               segment.speedHz,
+               segment.csChange,
+               segment.txWidth,
+               segment.rxWidth);
+    }
+
+    return submit();
+}
+
+void LinuxSpi::append(const std::uint8_t* txBytes,
+                      std::uint8_t* rxBytes,
+                      std::size_t size,
+                      std::uint32_t speedHz,
+                      bool csChange,
+                      BusWidth txWidth,
+                      BusWidth rxWidth)
+{
+    // Full chunks must stay within bufsiz after spidev rounds them up to cTransferAlignment.
+    auto maxChunkSize = std::max(m_bufferSize & ~(cTransferAlignment - 1), cTransferAlignment);
+    std::size_t offset{};
+    do {
+        auto chunkSize = std::min(size - offset, maxChunkSize);
+        bool lastChunk = (offset + chunkSize) == size;
+
+        spi_ioc_transfer transfer{};
+        transfer.tx_buf = (txBytes != nullptr) ? reinterpret_cast<std::uintptr_t>(txBytes + offset) : 0; // NOLINT
+        transfer.rx_buf = (rxBytes != nullptr) ? reinterpret_cast<std::uintptr_t>(rxBytes + offset) : 0; // NOLINT
+        transfer.len = std::uint32_t(chunkSize);
+        transfer.speed_hz = speedHz;
+        transfer.cs_change = (lastChunk && csChange) ? 1 : 0;
+        transfer.tx_nbits = (txBytes != nullptr || rxBytes == nullptr) ? std::uint8_t(txWidth) : 0;
+        transfer.rx_nbits = (rxBytes != nullptr) ? std::uint8_t(rxWidth) : 0;
+        m_transfers.push_back(transfer);
+
+        offset += chunkSize;
+    } while (offset < size);
+}
+
+std::error_code LinuxSpi::submit()
+{
+    auto alignedSize = [](std::size_t size) { return (size + cTransferAlignment - 1) & ~(cTransferAlignment - 1); };
+    std::error_code result = Error::eOk;
+
+    for (std::size_t first = 0; first < m_transfers.size();) {
+        std::size_t txTotal{};
+        std::size_t rxTotal{};
+        std::size_t last = first;
+
+        for (; last < m_transfers.size() && (last - first) < cMaxTransfersPerMessage; ++last) {
+            const auto& transfer = m_transfers[last];
+            auto txSize = txTotal + ((transfer.tx_buf != 0) ? alignedSize(transfer.len) : 0);
+            auto rxSize = rxTotal + ((transfer.rx_buf != 0) ? alignedSize(transfer.len) : 0);
+            if (last != first && (txSize > m_bufferSize || rxSize > m_bufferSize))
+                break;
+
+            txTotal = txSize;
+            rxTotal = rxSize;
+        }
+
+        // cs_change on the last transfer of the message means "keep chip select asserted after the message", while
+        // the end of the message deasserts it anyway. Invert it, so that requested chip select state is preserved
+        // across the message boundary.
+        auto& tail = m_transfers[last - 1];
+        tail.cs_change = (last == m_transfers.size()) ? 0 : std::uint8_t(!tail.cs_change);
+
+        if (::ioctl(m_fd, messageRequest(last - first), &m_transfers[first]) < 0) { // NOLINT
+            result = toError(errno);
+            SpiLogger::debug("SPI_IOC_MESSAGE failed: count={}, err={}", last - first, result.message());
+            break;
+        }
+
+        first = last;
+    }
+
+    m_transfers.clear();
+    return result;
+}
+
+} // namespace hal::spi
@@ -0,0 +1,338 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#include "hal/uart/LinuxUart.hpp"
+
+#include "hal/Error.hpp"
+#include "hal/logger/interfaces.hpp"
+
+#include <asm/termbits.h>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <utility>
+
+namespace hal::uart {
+namespace {
+
+/// Converts the errno value reported by the tty driver into the error code.
+/// @param errnoValue       Value of errno.
+/// @return Error code corresponding to the given errno value.
+std::error_code toError(int errnoValue)
+{
+    switch (errnoValue) {
+        case EINVAL: return Error::eInvalidArgument;
+        case ENOMEM: return Error::eNoMemory;
+        case ENOTTY:
+        case EOPNOTSUPP: return Error::eNotSupported;
+        default: return Error::eHardwareError;
+    }
+}
+
+/// Converts the given mode into the termios control flags.
+/// @param mode             Mode to be converted.
+/// @return Termios control flags (CSIZE, PARENB, PARODD and CSTOPB bits).
+tcflag_t toControlFlags(Mode mode)
+{
+    auto format = frameFormat(mode);
+    tcflag_t flags{};
+    switch (format.dataBits) {
+        case 5: flags |= CS5; break; // NOLINT
+        case 6: flags |= CS6; break; // NOLINT
+        case 7: flags |= CS7; break; // NOLINT
+        default: flags |= CS8; break;
+    }
+
+    if (format.parity != Parity::eNone)
+        flags |= PARENB;
+
+    if (format.parity == Parity::eOdd)
+        flags |= PARODD;
+
+    if (format.stopBits == 2)
+        flags |= CSTOPB;
+
+    return flags;
+}
+
+} // namespace
+
+LinuxUart::LinuxUart(std::string devicePath)
+    : m_devicePath(std::move(devicePath))
+{}
+
+LinuxUart::~LinuxUart()
+{
+    // Closed here, because IUart destructor is not able to call the driver anymore.
+    close();
+}
+
+std::error_code LinuxUart::drvOpen()
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    m_fd = ::open(m_devicePath.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd == m_cInvalidFd) {
+        UartLogger::error("Failed to open '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    if (auto error = applySettings()) {
+        ::close(m_fd);
+        m_fd = m_cInvalidFd;
+        return error;
+    }
+
+    enableLowLatency();
+
+    // Data received before the device was opened belongs to nobody.
+    ::ioctl(m_fd, TCFLSH, TCIOFLUSH); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    UartLogger::debug("Opened '{}'", m_devicePath);
+    return Error::eOk;
+}
+
+std::error_code LinuxUart::drvClose()
+{
+    if (::close(m_fd) != 0) {
+        UartLogger::error("Failed to close '{}': {}", m_devicePath, std::strerror(errno));
+        return Error::eHardwareError;
+    }
+
+    m_fd = m_cInvalidFd;
+    return Error::eOk;
+}
+
+std::error_code LinuxUart::drvSetBaudrate(Baudrate baudrate)
+{
+    auto previous = std::exchange(m_baudrate, baudrate);
+    if (m_fd == m_cInvalidFd)
+        return Error::eOk;
+
+    auto error = applySettings();
+    if (error)
+        m_baudrate = previous;
+
+    return error;
+}
+
+std::error_code LinuxUart::drvSetMode(Mode mode)
+{
+    auto previous = std::exchange(m_mode, mode);
+    if (m_fd == m_cInvalidFd)
+        return Error::eOk;
+
+    auto error = applySettings();
+    if (error)
+        m_mode = previous;
+
+    return error;
+}
+
+std::error_code LinuxUart::drvSetFlowControl(FlowControl flowControl)
+{
+    auto previous = std::exchange(m_flowControl, flowControl);
+    if (m_fd == m_cInvalidFd)
+        return Error::eOk;
+
+    auto error = applySettings();
+    if (error)
+        m_flowControl = previous;
+
+    return error;
+}
+
+std::error_code LinuxUart::drvWrite(const std::uint8_t* bytes, std::size_t size)
+{
+    std::size_t written{};
+    while (written < size) {
+        auto result = ::write(m_fd, bytes + written, size - written);
+        if (result >= 0) {
+            written += static_cast<std::size_t>(result);
+            continue;
+        }
+
+        if (errno == EINTR)
+            continue;
+
+        if (errno != EAGAIN) {
+            UartLogger::error("Failed to write {} bytes: {}", size - written, std::strerror(errno));
+            return toError(errno);
+        }
+
+        // Kernel buffer is full, so the rest is written as soon as the driver makes some space.
+        if (auto error = wait(POLLOUT, osal::Timeout(m_cWriteTimeout))) {
+            UartLogger::error("Failed to write {} bytes: err={}", size - written, error.message());
+            return error;
+        }
+    }
+
+    return Error::eOk;
+}
+
+Result<std::size_t> LinuxUart::drvRead(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout)
+{
+    std::size_t received{};
+    while (received < size) {
+        auto result = ::read(m_fd, bytes + received, size - received);
+        if (result > 0) {
+            received += static_cast<std::size_t>(result);
+            continue;
+        }
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        std::error_code error;
+        if (result == 0)
+            // With VMIN=1 zero is returned only on hangup, so waiting for more data would never end.
+            error = Error::eHardwareError;
+        else if (errno == EAGAIN)
+            error = wait(POLLIN, timeout);
+        else
+            error = toError(errno);
+
+        if (error == Error::eTimeout)
+            break;
+
+        if (error) {
+            // Bytes received before the failure (e.g. hangup) are returned first, the next read reports it.
+            if (received != 0)
+                break;
+
+            UartLogger::error("Failed to read {} bytes from '{}': err={}", size, m_devicePath, error.message());
+            return error;
+        }
+    }
+
+    return received;
+}
+
+std::error_code LinuxUart::drvDrain()
+{
+    // Same as tcdrain(), which cannot be used together with termios2.
+    if (::ioctl(m_fd, TCSBRK, 1) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        UartLogger::error("Failed to drain '{}': {}", m_devicePath, std::strerror(errno));
+        return toError(errno);
+    }
+
+    return Error::eOk;
+}
+
+std::error_code LinuxUart::applySettings()
+{
+    termios2 settings{};
+    if (::ioctl(m_fd, TCGETS2, &settings) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        UartLogger::error("Failed to read settings of '{}': {}", m_devicePath, std::strerror(errno));
+        return toError(errno);
+    }
+
+    // Raw mode: no line editing, no echo, no signals and no translation of the bytes.
+    settings.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY | INPCK);
+    settings.c_oflag &= ~OPOST;
+    settings.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    settings.c_cflag &= ~(CBAUD | CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+    settings.c_cflag |= CREAD | CLOCAL | BOTHER | toControlFlags(m_mode);
+    settings.c_ispeed = static_cast<speed_t>(m_baudrate);
+    settings.c_ospeed = static_cast<speed_t>(m_baudrate);
+    // With VMIN=0 read() returns zero instead of EAGAIN, which would be indistinguishable from the hangup.
+    settings.c_cc[VMIN] = 1;
+    settings.c_cc[VTIME] = 0;
+
+    if (frameFormat(m_mode).parity != Parity::eNone)
+        settings.c_iflag |= INPCK;
+
+    switch (m_flowControl) {
+        case FlowControl::eNone: break;
+        case FlowControl::eRtsCts: settings.c_cflag |= CRTSCTS; break;
+        case FlowControl::eXonXoff: settings.c_iflag |= IXON | IXOFF; break;
+    }
+
+    if (::ioctl(m_fd, TCSETS2, &settings) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        UartLogger::error("Failed to set baudrate={} on '{}': {}",
+                          static_cast<std::uint32_t>(m_baudrate),
+                          m_devicePath,
+                          std::strerror(errno));
+        return toError(errno);
+    }
+
+    return Error::eOk;
+}
+
+void LinuxUart::enableLowLatency()
+{
+    serial_struct serial{};
+    if (::ioctl(m_fd, TIOCGSERIAL, &serial) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg)
+        UartLogger::debug("Low latency mode is not supported by '{}'", m_devicePath);
+        return;
+    }
+
+    serial.flags |= ASYNC_LOW_LATENCY;
+    if (::ioctl(m_fd, TIOCSSERIAL, &serial) != 0) // NOLINT(cppcoreguidelines-pro-type-vararg)
+        UartLogger::debug("Failed to enable low latency mode on '{}': {}", m_devicePath, std::strerror(errno));
+}
+
+std::error_code LinuxUart::wait(short events, osal::Timeout timeout) // NOLINT(google-runtime-int)
+{
+    while (true) {
+        // Infinite timeout doesn't fit into int, which is mapped to the infinite poll().
+        auto timeoutMs = osal::durationMs(timeout);
+        int pollTimeout = (timeoutMs > INT_MAX) ? -1 : static_cast<int>(timeoutMs);
+
+        pollfd descriptor{m_fd, events, 0};
+        auto result = ::poll(&descriptor, 1, pollTimeout);
+        if (result > 0) {
+            if ((descriptor.revents & (POLLERR | POLLNVAL)) != 0)
+                return Error::eHardwareError;
+
+            // POLLHUP comes together with POLLIN as long as there is data left to be read.
+            if ((descriptor.revents & events) == 0 && (descriptor.revents & POLLHUP) != 0)
+                return Error::eHardwareError;
+
+            return Error::eOk;
+        }
+
+        if (result == 0)
+            return Error::eTimeout;
+
+        if (errno != EINTR) {
+            UartLogger::error("Failed to wait for '{}': {}", m_devicePath, std::strerror(errno));
+            return toError(errno);
+        }
+    }
+}
+
+} // namespace hal::uart
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/i2c/II2c.hpp"
+
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+namespace hal::i2c {
+
+/// Represents the I2C bus controller available through the Linux i2c-dev interface (/dev/i2c-N). Each transaction
+/// is submitted to the kernel as a single I2C_RDWR ioctl, so combined transactions (e.g. register address write
+/// followed by the repeated start and read) cost exactly one syscall. Adapters, which support only SMBus transfers,
+/// are handled with the I2C_SMBUS ioctl for the transactions that can be expressed as SMBus commands.
+/// @note i2c-dev always generates the stop condition at the end of the ioctl, so write() without stop fails with
+///       Error::eNotSupported. Use transfer() for transactions requiring the repeated start.
+/// @note Bus frequency is defined by the kernel (e.g. in the device tree) and cannot be changed by this driver.
+///       setParams() selects only the addressing mode (7-bit by default).
+class LinuxI2c : public II2c {
+public:
+    /// Constructor.
+    /// @param devicePath       Path to the i2c-dev device (e.g. "/dev/i2c-1").
+    explicit LinuxI2c(std::string devicePath);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because LinuxI2c is not meant to be copy-constructed.
+    LinuxI2c(const LinuxI2c&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because LinuxI2c is not meant to be move-constructed.
+    LinuxI2c(LinuxI2c&&) = delete;
+
+    /// Destructor.
+    ~LinuxI2c() override;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxI2c is not meant to be copy-assigned.
+    LinuxI2c& operator=(const LinuxI2c&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxI2c is not meant to be move-assigned.
+    LinuxI2c& operator=(LinuxI2c&&) = delete;
+
+private:
+    /// @see II2c::drvSetParams().
+    std::error_code drvSetParams(I2cParams params) override;
+
+    /// @see II2c::drvOpen().
+    std::error_code drvOpen() override;
+
+    /// @see II2c::drvClose().
+    std::error_code drvClose() override;
+
+    /// @see II2c::drvWrite().
+    std::error_code drvWrite(std::uint16_t address,
+                             const std::uint8_t* bytes,
+                             std::size_t size,
+                             bool stop,
+                             osal::Timeout timeout) override;
+
+    /// @see II2c::drvRead().
+    Result<std::size_t>
+    drvRead(std::uint16_t address, std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) override;
+
+    /// @see II2c::drvTransfer().
+    std::error_code drvTransfer(const I2cMessage* messages, std::size_t count, osal::Timeout timeout) override;
+
+    /// @see II2c::drvProbe().
+    std::error_code drvProbe(std::uint16_t address, osal::Timeout timeout) override;
+
+    /// Sets the adapter timeout used by the kernel for the next transfers. Timeout is updated only if it differs
+    /// from the previously set one, so that transfers with the same timeout don't cost an additional syscall.
+    /// @param timeout          Maximal time of the transfer.
+    /// @return Error code of the operation.
+    std::error_code setTimeout(osal::Timeout timeout);
+
+    /// Performs the given transaction with the I2C_SMBUS ioctl.
+    /// @param messages         Array of messages to be transferred.
+    /// @param count            Number of messages in the array.
+    /// @return Error code of the operation.
+    /// @note Only transactions that can be expressed as SMBus commands are supported.
+    std::error_code smbusTransfer(const I2cMessage* messages, std::size_t count);
+
+    /// Performs the single SMBus command.
+    /// @param address          Address of the I2C slave device.
+    /// @param readWrite        Direction of the command (I2C_SMBUS_READ or I2C_SMBUS_WRITE).
+    /// @param command          Command (register) byte.
+    /// @param protocol         SMBus protocol (one of I2C_SMBUS_QUICK, I2C_SMBUS_BYTE, etc.).
+    /// @param data             Data of the command (may be nullptr for the quick command).
+    /// @return Error code of the operation.
+    std::error_code smbusAccess(std::uint16_t address,
+                                std::uint8_t readWrite,
+                                std::uint8_t command,
+                                std::uint32_t protocol,
+                                void* data);
+
+private:
+    static constexpr int m_cInvalidFd = -1;
+    static constexpr std::uint16_t m_cInvalidAddress = 0xffff;
+    static constexpr std::uint32_t m_cTimeoutUnitMs = 10;
+    static constexpr std::uint32_t m_cMaxTimeoutMs = 60'000;
+
+    std::string m_devicePath;
+    int m_fd{m_cInvalidFd};
+    unsigned long m_functionality{}; // NOLINT(google-runtime-int)
+    std::uint32_t m_timeoutUnits{};
+    std::uint16_t m_slaveAddress{m_cInvalidAddress};
+    AddressingMode m_addressingMode{AddressingMode::e7bit};
+};
+
+} // namespace hal::i2c
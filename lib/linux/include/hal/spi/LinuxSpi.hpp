@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/spi/ISpi.hpp"
+
+#include <linux/spi/spidev.h>
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace hal::spi {
+
+/// Represents the SPI device available through the Linux spidev interface (/dev/spidevX.Y). Chip select is driven
+/// by the kernel, so each instance represents the single device on the bus. Transfers are described
+/// with spi_ioc_transfer entries and submitted in as few SPI_IOC_MESSAGE ioctls as the spidev buffer size allows.
+/// Transfers larger than the spidev buffer are split into chunks and chip select is kept asserted between them.
+/// @note spidev doesn't support timeouts, so timeout arguments are ignored.
+class LinuxSpi : public ISpi {
+public:
+    /// Constructor.
+    /// @param devicePath       Path to the spidev device (e.g. "/dev/spidev0.0").
+    explicit LinuxSpi(std::string devicePath);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because LinuxSpi is not meant to be copy-constructed.
+    LinuxSpi(const LinuxSpi&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because LinuxSpi is not meant to be move-constructed.
+    LinuxSpi(LinuxSpi&&) = delete;
+
+    /// Destructor.
+    ~LinuxSpi() override;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxSpi is not meant to be copy-assigned.
+    LinuxSpi& operator=(const LinuxSpi&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxSpi is not meant to be move-assigned.
+    LinuxSpi& operator=(LinuxSpi&&) = delete;
+
+private:
+    /// @see ISpi::drvOpen().
+    std::error_code drvOpen() override;
+
+    /// @see ISpi::drvClose().
+    std::error_code drvClose() override;
+
+    /// @see ISpi::drvSetParams().
+    std::error_code drvSetParams(SpiParams params) override;
+
+    /// @see ISpi::drvWrite().
+    std::error_code drvWrite(const std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) override;
+
+    /// @see ISpi::drvRead().
+    Result<std::size_t> drvRead(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) override;
+
+    /// @see ISpi::drvTransfer().
+    Result<std::size_t>
+    drvTransfer(const std::uint8_t* txBytes, std::uint8_t* rxBytes, std::size_t size, osal::Timeout timeout) override;
+
+    /// @see ISpi::drvTransferList().
+    std::error_code drvTransferList(const SpiSegment* segments, std::size_t count, osal::Timeout timeout) override;
+
+    /// Appends the transfer to the list of pending transfers, splitting it into chunks not larger than the spidev
+    /// buffer.
+    /// @param txBytes          Data to be transmitted (may be nullptr).
+    /// @param rxBytes          Place where received data should be placed (may be nullptr).
+    /// @param size             Number of bytes to transmit and/or receive.
+    /// @param speedHz          Clock frequency of the transfer (0 means the current bus frequency).
+    /// @param csChange         Flag indicating if chip select should be deasserted after the transfer.
+    /// @param txWidth          Bus width used to transmit the data.
+    /// @param rxWidth          Bus width used to receive the data.
+    void append(const std::uint8_t* txBytes,
+                std::uint8_t* rxBytes,
+                std::size_t size,
+                std::uint32_t speedHz,
+                bool csChange,
+                BusWidth txWidth = BusWidth::eSingle,
+                BusWidth rxWidth = BusWidth::eSingle);
+
+    /// Submits all pending transfers and clears the list. Consecutive transfers are packed into the single
+    /// SPI_IOC_MESSAGE ioctl as long as they fit into the spidev buffer.
+    /// @return Error code of the operation.
+    std::error_code submit();
+
+private:
+    static constexpr int m_cInvalidFd = -1;
+    static constexpr std::size_t m_cDefaultBufferSize = 4096;
+
+    std::string m_devicePath;
+    int m_fd{m_cInvalidFd};
+    std::size_t m_bufferSize{m_cDefaultBufferSize};
+    std::vector<spi_ioc_transfer> m_transfers;
+};
+
+} // namespace hal::spi
@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/// @file
+/// @author Kuba Sejdak
+/// @copyright BSD 2-Clause License
+///
+/// Copyright (c) 2023, Kuba Sejdak <kuba.sejdak@gmail.com>
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+/// 1. Redistributions of source code must retain the above copyright notice, this
+///    list of conditions and the following disclaimer.
+///
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+///    this list of conditions and the following disclaimer in the documentation
+///    and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+/// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+/////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "hal/uart/IUart.hpp"
+
+#include <osal/Timeout.hpp>
+#include <utils/types/Result.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+namespace hal::uart {
+
+/// Represents the UART available as the Linux tty device (e.g. /dev/ttyS0, /dev/ttyUSB0 or the pseudo-terminal).
+/// Device is configured in raw mode with the termios2 interface, so any baud rate supported by the hardware can be
+/// set (BOTHER). File descriptor is non-blocking: reads wait for the data with poll() honoring the given timeout
+/// and writes handle partial writes by waiting for the space in the kernel buffer. Low latency mode
+/// (ASYNC_LOW_LATENCY) is enabled if the driver supports it.
+/// @note Settings can be changed while opened, because pending data is drained first (see IUart::drain()).
+/// @note Write fails with Error::eTimeout, if the kernel buffer doesn't accept any byte for m_cWriteTimeout (e.g.
+///       because the peer holds CTS deasserted). Hangup (e.g. unplugged USB adapter or closed pseudo-terminal
+///       master) is reported as Error::eHardwareError.
+class LinuxUart : public IUart {
+public:
+    /// Constructor.
+    /// @param devicePath       Path to the tty device (e.g. "/dev/ttyUSB0").
+    explicit LinuxUart(std::string devicePath);
+
+    /// Copy constructor.
+    /// @note This constructor is deleted, because LinuxUart is not meant to be copy-constructed.
+    LinuxUart(const LinuxUart&) = delete;
+
+    /// Move constructor.
+    /// @note This constructor is deleted, because LinuxUart is not meant to be move-constructed.
+    LinuxUart(LinuxUart&&) = delete;
+
+    /// Destructor.
+    ~LinuxUart() override;
+
+    /// Copy assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxUart is not meant to be copy-assigned.
+    LinuxUart& operator=(const LinuxUart&) = delete;
+
+    /// Move assignment operator.
+    /// @return Reference to self.
+    /// @note This operator is deleted, because LinuxUart is not meant to be move-assigned.
+    LinuxUart& operator=(LinuxUart&&) = delete;
+
+private:
+    /// @see IUart::drvOpen().
+    std::error_code drvOpen() override;
+
+    /// @see IUart::drvClose().
+    std::error_code drvClose() override;
+
+    /// @see IUart::drvSetBaudrate().
+    std::error_code drvSetBaudrate(Baudrate baudrate) override;
+
+    /// @see IUart::drvSetMode().
+    std::error_code drvSetMode(Mode mode) override;
+
+    /// @see IUart::drvSetFlowControl().
+    std::error_code drvSetFlowControl(FlowControl flowControl) override;
+
+    /// @see IUart::drvWrite().
+    std::error_code drvWrite(const std::uint8_t* bytes, std::size_t size) override;
+
+    /// @see IUart::drvRead().
+    Result<std::size_t> drvRead(std::uint8_t* bytes, std::size_t size, osal::Timeout timeout) override;
+
+    /// @see IUart::drvDrain().
+    std::error_code drvDrain() override;
+
+    /// Applies the current settings to the opened device.
+    /// @return Error code of the operation.
+    std::error_code applySettings();
+
+    /// Enables the low latency mode of the serial driver.
+    /// @note Failure is not an error, because not every tty driver (e.g. pseudo-terminal) supports it.
+    void enableLowLatency();
+
+    /// Waits until the device is ready for the given operation.
+    /// @param events           Events to wait for (POLLIN or POLLOUT).
+    /// @param timeout          Maximal time to wait.
+    /// @return Error code of the operation.
+    /// @note Error::eHardwareError is returned on hangup, unless there is still data to be read.
+    std::error_code wait(short events, osal::Timeout timeout); // NOLINT(google-runtime-int)
+
+private:
+    static constexpr int m_cInvalidFd = -1;
+    static constexpr std::chrono::milliseconds m_cWriteTimeout{1000};
+
+    std::string m_devicePath;
+    int m_fd{m_cInvalidFd};
+    Baudrate m_baudrate{Baudrate::e115200};
+    Mode m_mode{Mode::e8n1};
+    FlowControl m_flowControl{FlowControl::eNone};
+};
+
+} // namespace hal::uart
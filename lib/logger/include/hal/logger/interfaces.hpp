@@ -53,6 +53,12 @@ REGISTER_LOGGER(SpiLogger, "SPI", cDefaultLogLevel);
 
 } // namespace spi
 
+namespace uart {
+
+REGISTER_LOGGER(UartLogger, "UART", cDefaultLogLevel);
+
+} // namespace uart
+
 namespace time {
 
 REGISTER_LOGGER(RtcLogger, "RTC", cDefaultLogLevel);